@@ -0,0 +1,63 @@
+#include <kitpp/kitpp.hpp>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Route every new/delete of this program through the tracker
+KITPP_TRACK_GLOBAL_ALLOCATIONS();
+
+static std::vector<std::string> parse(int n)
+{
+    KITPP_MEM_SCOPE("parse");
+    std::vector<std::string> tokens;
+    for (int i = 0; i < n; ++i) {
+        tokens.push_back("token #" + std::to_string(i) + " long enough to need the heap");
+    }
+    return tokens;
+}
+
+static std::size_t index_tokens(const std::vector<std::string>& tokens)
+{
+    KITPP_MEM_SCOPE("index");
+    std::map<std::string, int> index;
+    for (const auto& t : tokens) {
+        ++index[t];
+    }
+    return index.size();
+}
+
+int main()
+{
+    kitpp::memory::enable_alloc_tracking(false);
+
+    std::size_t total = 0;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&total, w] {
+            KITPP_MEM_SCOPE("request");
+            for (int r = 0; r < 20; ++r) {
+                auto tokens = parse(200 + 50 * w);
+                total += index_tokens(tokens); // Races are fine for a demo counter
+            }
+        });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    // Explicit opt-in per container, recorded even without the global hook
+    {
+        KITPP_MEM_SCOPE("tracked_vector");
+        std::vector<double, kitpp::memory::TrackingAllocator<double>> samples;
+        for (int i = 0; i < 100000; ++i) {
+            samples.push_back(i);
+        }
+    }
+
+    KITPP_LOG_INFOF("indexed {} tokens", total);
+    kitpp::memory::print_alloc_report(std::cout);
+    kitpp::memory::log_alloc_report();
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// Arena and pool allocators against new / malloc for typical patterns.
+// Times are per "request" (a batch of allocations), best of 5 runs.
+
+volatile std::uint64_t g_sink = 0;
+
+template <typename Body>
+double ns_per_request(int requests, Body&& body)
+{
+    double best = 1e300;
+    for (int run = 0; run < 5; ++run) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < requests; ++r) {
+            body();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / requests);
+    }
+    return best;
+}
+
+void report(const char* pattern, const char* strategy, double ns, double baseline)
+{
+    KITPP_LOG_INFOF("{} | {}: {:.0} ns/request ({:.2}x vs first)", pattern, strategy, ns, baseline / ns);
+}
+
+struct Node {
+    std::uint64_t key;
+    double value[6];
+};
+
+int main()
+{
+    using namespace kitpp::memory;
+    constexpr int objects = 1000; // Allocations per request
+    constexpr int requests = 2000;
+
+    // Sizes of a mixed batch: 16..272 bytes
+    std::vector<std::size_t> sizes(objects);
+    for (int i = 0; i < objects; ++i) {
+        sizes[i] = 16 + (static_cast<std::size_t>(i) * 37) % 257;
+    }
+    std::vector<void*> ptrs(objects);
+
+    // --- 1. Short-lived batch, freed together ---
+    {
+        const char* p = "batch of 1000 mixed sizes";
+        double base = ns_per_request(requests, [&] {
+            for (int i = 0; i < objects; ++i) {
+                ptrs[i] = ::operator new(sizes[i]);
+                static_cast<char*>(ptrs[i])[0] = 1;
+            }
+            for (int i = 0; i < objects; ++i) {
+                ::operator delete(ptrs[i]);
+            }
+        });
+        report(p, "new/delete", base, base);
+        report(p, "malloc/free", ns_per_request(requests, [&] {
+            for (int i = 0; i < objects; ++i) {
+                ptrs[i] = std::malloc(sizes[i]);
+                static_cast<char*>(ptrs[i])[0] = 1;
+            }
+            for (int i = 0; i < objects; ++i) {
+                std::free(ptrs[i]);
+            }
+        }), base);
+        Arena arena;
+        report(p, "Arena + reset", ns_per_request(requests, [&] {
+            for (int i = 0; i < objects; ++i) {
+                ptrs[i] = arena.allocate(sizes[i]);
+                static_cast<char*>(ptrs[i])[0] = 1;
+            }
+            arena.reset();
+        }), base);
+    }
+
+    // --- 2. Fixed-size object churn (working set of 1000) ---
+    {
+        const char* p = "fixed-size churn";
+        std::vector<Node*> live(objects, nullptr);
+        double base = ns_per_request(requests, [&] {
+            for (int i = 0; i < objects; ++i) {
+                delete live[(i * 7) % objects];
+                live[(i * 7) % objects] = new Node { static_cast<std::uint64_t>(i), {} };
+            }
+        });
+        for (auto*& n : live) {
+            delete n;
+            n = nullptr;
+        }
+        report(p, "new/delete", base, base);
+        auto& pool = ObjectPool<Node>::local();
+        report(p, "ObjectPool::local", ns_per_request(requests, [&] {
+            for (int i = 0; i < objects; ++i) {
+                pool.destroy(live[(i * 7) % objects]);
+                live[(i * 7) % objects] = pool.create(Node { static_cast<std::uint64_t>(i), {} });
+            }
+        }), base);
+        for (auto* n : live) {
+            pool.destroy(n);
+        }
+    }
+
+    // --- 3. pmr containers ---
+    {
+        const char* p = "pmr::vector<pmr::string> x1000";
+        auto build = [&](std::pmr::memory_resource* mr) {
+            std::pmr::vector<std::pmr::string> v(mr);
+            for (int i = 0; i < objects; ++i) {
+                v.emplace_back("a string that is too long for the small buffer"); // Uses mr too
+            }
+            g_sink += v.size();
+        };
+        double base = ns_per_request(requests, [&] { build(std::pmr::new_delete_resource()); });
+        report(p, "new_delete_resource", base, base);
+        Arena arena;
+        ArenaResource arena_mr(arena);
+        report(p, "ArenaResource + reset", ns_per_request(requests, [&] {
+            build(&arena_mr);
+            arena.reset();
+        }), base);
+        report(p, "std::pmr::monotonic_buffer_resource", ns_per_request(requests, [&] {
+            std::pmr::monotonic_buffer_resource mono;
+            build(&mono);
+        }), base);
+    }
+    {
+        const char* p = "pmr::list<int> push/pop";
+        auto churn = [&](std::pmr::memory_resource* mr) {
+            std::pmr::list<int> l(mr);
+            for (int i = 0; i < objects; ++i) {
+                l.push_back(i);
+                if (i % 3 == 0) {
+                    l.pop_front();
+                }
+            }
+            g_sink += l.size();
+        };
+        double base = ns_per_request(requests, [&] { churn(std::pmr::new_delete_resource()); });
+        report(p, "new_delete_resource", base, base);
+        PoolResource pool_mr(sizeof(int) + 2 * sizeof(void*));
+        report(p, "PoolResource", ns_per_request(requests, [&] { churn(&pool_mr); }), base);
+    }
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <kitpp/kitpp.hpp>
+
+#include <string>
+
+int main()
+{
+    // Opt in once at startup; the KITPP_LOG_* macros stay the same.
+    // Callers only push into the ring, the writer thread does the formatting.
+    kitpp::log::AsyncOptions opts;
+    opts.capacity = 4096;
+    opts.overflow = kitpp::log::OverflowPolicy::CountDrops;
+    kitpp::log::start_async(opts);
+
+    KITPP_LOG_INFO("Async logging enabled");
+    KITPP_LOG_THREAD_CONTEXT("Main Thread");
+
+#pragma omp parallel for
+    for (int i = 0; i < 64; ++i) {
+        KITPP_LOG_INFO("iteration " + std::to_string(i) + " on cpu " + std::to_string(kitpp::cpu_index()));
+    }
+
+    // Make sure everything above is on screen before continuing
+    kitpp::log::flush();
+    KITPP_LOG_WARN("Dropped records so far: " + std::to_string(kitpp::log::dropped_records()));
+
+    int answer = 42;
+    KITPP_LOG_VAR(answer);
+
+    // Remaining records are flushed automatically at exit
+    return 0;
+}
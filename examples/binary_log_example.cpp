@@ -0,0 +1,29 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <string>
+
+// Decode the output with:  ./build/kitpp-logdecode kitpp_log.bin
+int main()
+{
+    const int iterations = 1000000;
+
+    if (!kitpp::log::start_binary("kitpp_log.bin")) {
+        KITPP_LOG_ERROR("Could not open kitpp_log.bin");
+        return 1;
+    }
+
+    // Only the *F macros take the binary path; arguments are copied raw
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        KITPP_LOG_INFOF("iteration {} residual {:.6} converged={}", i, 1.0 / (i + 1), i > 100);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    KITPP_LOG_WARNF("phase '{}' done", std::string("solve"));
+    kitpp::log::stop_binary();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    KITPP_LOG_INFOF("Binary logging: {:.1} ns per call ({} calls)", ns, iterations);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+// Average cost of one now() call, measured with the clock itself
+template <typename Clock>
+double read_cost_ns(int reads)
+{
+    typename Clock::tick sink {};
+    auto t0 = Clock::now();
+    for (int i = 0; i < reads; ++i) {
+        sink += Clock::now() - t0;
+    }
+    auto t1 = Clock::now();
+    volatile double keep = static_cast<double>(sink);
+    (void)keep;
+    return static_cast<double>(Clock::to_ns(t1 - t0)) / reads;
+}
+
+double work(int n)
+{
+    double acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += std::sqrt(static_cast<double>(i));
+    }
+    return acc;
+}
+
+int main()
+{
+    using namespace kitpp::clocks;
+    const auto& tsc = detail::tsc_info();
+
+    KITPP_LOG_INFOF("default timer clock: {}", DefaultClock::name);
+    KITPP_LOG_INFOF("TSC reliable: {} (rdtscp: {}, {:.3} GHz)", TscClock::reliable(), tsc.has_rdtscp, tsc.ghz);
+
+    constexpr int reads = 1000000;
+    KITPP_LOG_INFOF("steady_clock::now()  {:.1} ns/read", read_cost_ns<SteadyClock>(reads));
+    KITPP_LOG_INFOF("omp_get_wtime()      {:.1} ns/read", read_cost_ns<OmpClock>(reads));
+    KITPP_LOG_INFOF("rdtscp (TscClock)    {:.1} ns/read", read_cost_ns<TscClock>(reads));
+
+    // The same short scope under each clock
+    double total = 0.0;
+    {
+        kitpp::BasicScopeTimer<TscClock> t("work(200) tsc", __FILE__, __LINE__, __func__);
+        total += work(200);
+    }
+    {
+        kitpp::BasicScopeTimer<SteadyClock> t("work(200) steady", __FILE__, __LINE__, __func__);
+        total += work(200);
+    }
+    {
+        kitpp::BasicScopeTimer<OmpClock> t("work(200) omp", __FILE__, __LINE__, __func__);
+        total += work(200);
+    }
+
+    KITPP_LOG_INFOF("total = {:.3}", total);
+    return 0;
+}
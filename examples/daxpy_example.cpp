@@ -1,5 +1,6 @@
 #include <kitpp/kitpp.hpp>
 #include <kitpp/math/DAXPY.hpp> // Assumes DAXPY.hpp is in include/kitpp/math/
+#include <kitpp/math/dispatch.hpp> // detect_isa
 
 #include <chrono>
 #include <iomanip>
@@ -20,10 +21,15 @@ int main()
 
     KITPP_LOG_INFO("Initializing Vectors with " + std::to_string(n) + " elements...");
 
-    // Initialize vectors
-    std::vector<double> x(n, 1.0);
-    std::vector<double> y(n, 2.0);
-    std::vector<double> y_copy = y; // Backup for second run
+    // Initialize vectors. The first write to each fresh page is a minor
+    // fault; the resource scope shows how much of the time that costs.
+    std::vector<double> x, y, y_copy;
+    {
+        KITPP_RESOURCE_SCOPE("Vector init (first touch)");
+        x.assign(n, 1.0);
+        y.assign(n, 2.0);
+        y_copy = y; // Backup for second run
+    }
     double alpha = 0.5;
 
     std::stringstream ss;
@@ -33,6 +39,7 @@ int main()
     // --- Scalar Test ---
     {
         KITPP_SCOPE_TIMER("Scalar DAXPY");
+        KITPP_RESOURCE_SCOPE_PROCESS("Scalar DAXPY (pages already touched)");
         auto start = std::chrono::high_resolution_clock::now();
 
         axpy_scalar(alpha, x, y);
@@ -50,6 +57,12 @@ int main()
         // (Re-calculate or store in variable scope if needed, here just keeping structure)
     }
 
+    // axpy_avx needs AVX2 + FMA; kitpp::math::axpy() picks the kernel itself
+    if (kitpp::math::detect_isa() < kitpp::math::Isa::Avx2) {
+        KITPP_LOG_WARN("AVX2 not available on this CPU, skipping the AVX runs");
+        return 0;
+    }
+
     // --- AVX Test ---
     {
         y = y_copy; // Reset Y
@@ -0,0 +1,72 @@
+#include <kitpp/kitpp.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Particle {
+    std::string name;
+    std::vector<double> samples;
+    std::optional<std::string> note;
+};
+
+// Tell get_footprint() what a Particle owns
+template <>
+struct kitpp::memory::DeepSize<Particle> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const Particle& p, Footprint& f)
+    {
+        kitpp::memory::add_heap(p.name, f);
+        kitpp::memory::add_heap(p.samples, f);
+        kitpp::memory::add_heap(p.note, f);
+    }
+};
+
+template <typename T>
+void show(const char* what, const T& obj)
+{
+    const auto f = kitpp::memory::get_footprint(obj);
+    KITPP_LOG_INFOF("{}: {} bytes (used {}, slack {}, overhead {})", what, f.total(), f.used, f.slack, f.overhead);
+}
+
+int main()
+{
+    std::vector<double> values(1000);
+    values.reserve(1500);
+    show("vector<double>(1000), capacity 1500", values);
+
+    std::vector<std::string> words;
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back("word number " + std::to_string(i) + " is long enough to leave SSO");
+    }
+    show("vector<string> x1000", words);
+
+    std::unordered_map<std::string, std::vector<int>> index;
+    for (int i = 0; i < 500; ++i) {
+        index["key_that_needs_the_heap_" + std::to_string(i)] = std::vector<int>(i % 16);
+    }
+    show("unordered_map<string, vector<int>> x500", index);
+
+    std::map<int, int> tree;
+    for (int i = 0; i < 1000; ++i) {
+        tree[i] = i;
+    }
+    show("map<int, int> x1000", tree);
+
+    std::vector<std::unique_ptr<Particle>> particles;
+    for (int i = 0; i < 100; ++i) {
+        auto p = std::make_unique<Particle>();
+        p->name = "particle with a long descriptive name #" + std::to_string(i);
+        p->samples.resize(64);
+        particles.push_back(std::move(p));
+    }
+    show("vector<unique_ptr<Particle>> x100", particles);
+
+    KITPP_LOG_MEM(words, "deep_size_example");
+    KITPP_LOG_MEM(index, "deep_size_example");
+    KITPP_LOG_MEM(particles, "deep_size_example");
+    return 0;
+}
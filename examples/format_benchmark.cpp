@@ -0,0 +1,125 @@
+// Per-call cost of the formatting helpers used by the loggers and timers,
+// against the stringstream versions they replaced.
+
+#include <kitpp/kitpp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// --- Allocation Counter ---
+static std::atomic<long long> g_allocs { 0 };
+
+void* operator new(std::size_t n)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// --- Previous Implementations ---
+namespace legacy {
+
+std::string get_current_timestamp()
+{
+    using namespace std::chrono;
+    auto now = system_clock::now();
+    auto in_time_t = system_clock::to_time_t(now);
+    auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+    std::stringstream ss;
+    std::tm tm_buf;
+    localtime_r(&in_time_t, &tm_buf);
+    ss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
+    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
+    return ss.str();
+}
+
+std::string format_duration(long long duration_us)
+{
+    using namespace std::chrono;
+    auto d = microseconds(duration_us);
+    auto h = duration_cast<hours>(d);
+    d -= h;
+    auto m = duration_cast<minutes>(d);
+    d -= m;
+    auto s = duration_cast<seconds>(d);
+    d -= s;
+    auto ms = duration_cast<milliseconds>(d);
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(2) << h.count() << ":"
+       << std::setfill('0') << std::setw(2) << m.count() << ":"
+       << std::setfill('0') << std::setw(2) << s.count() << "."
+       << std::setfill('0') << std::setw(3) << ms.count();
+    return ss.str();
+}
+
+std::string tid_string()
+{
+    std::ostringstream os;
+    os << std::this_thread::get_id();
+    return os.str();
+}
+
+std::string var_value(double v)
+{
+    std::ostringstream ss;
+    ss << v;
+    return ss.str();
+}
+
+} // namespace legacy
+
+template <typename Func>
+void bench(const char* name, Func f)
+{
+    const int iters = 200000;
+    std::size_t sink = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sink += f(i); // Warm up thread-local caches
+    }
+    long long allocs_before = g_allocs.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+        sink += f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    long long allocs = g_allocs.load() - allocs_before;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iters;
+    KITPP_LOG_INFOF("{}: {:.1} ns/call, {:.2} allocs/call (sink {})",
+        name, ns, static_cast<double>(allocs) / iters, sink % 10);
+}
+
+int main()
+{
+    using namespace kitpp::detail::time;
+
+    bench("timestamp  (legacy)", [](int) { return legacy::get_current_timestamp().size(); });
+    bench("timestamp  (cached)", [](int) { return timestamp_view().size(); });
+
+    bench("duration   (legacy)", [](int i) { return legacy::format_duration(i * 1234LL).size(); });
+    bench("duration   (to_chars)", [](int i) { return format_duration_view(i * 1234LL).size(); });
+
+    bench("tid_string (legacy)", [](int) { return legacy::tid_string().size(); });
+    bench("tid_string (cached)", [](int) { return kitpp::tid_string().size(); });
+
+    bench("var value  (legacy)", [](int i) { return legacy::var_value(i * 0.5).size(); });
+    bench("var value  (to_chars)", [](int i) {
+        std::string& buf = kitpp::log::detail::value_buffer();
+        buf.clear();
+        kitpp::log::detail::append_value(buf, i * 0.5, {});
+        return buf.size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+#include <fstream>
+
+// Simulated request: usually short, occasionally 20x slower
+double handle_request(int i)
+{
+    const int work = (i % 500 == 0) ? 20000 : 1000;
+    double acc = 0.0;
+    for (int k = 0; k < work; ++k) {
+        acc += std::sqrt(static_cast<double>(k + i));
+    }
+    return acc;
+}
+
+int main()
+{
+    using kitpp::clocks::DefaultClock;
+
+    // One histogram shared by all threads: recording is an atomic increment
+    kitpp::stats::Histogram latency(1, 10LL * 1000000000LL, 3); // 1 ns .. 10 s, 3 digits
+
+    double total = 0.0;
+#pragma omp parallel for reduction(+ : total)
+    for (int i = 0; i < 50000; ++i) {
+        auto t0 = DefaultClock::now();
+        total += handle_request(i);
+        latency.record(DefaultClock::to_ns(DefaultClock::now() - t0));
+    }
+
+    KITPP_LOG_INFOF("requests: {}  mean {:.1} ns  p50 {} ns  p99 {} ns  p99.9 {} ns  max {} ns",
+        latency.count(), latency.mean(), latency.value_at_percentile(50.0),
+        latency.value_at_percentile(99.0), latency.value_at_percentile(99.9), latency.max());
+
+    // HDR percentile text (plot with HdrHistogram's plotter) and raw buckets, in microseconds
+    std::ofstream hgrm("latency.hgrm");
+    latency.write_percentiles(hgrm, 1000.0);
+    std::ofstream csv("latency_buckets.csv");
+    latency.write_csv(csv, 1000.0);
+
+    // Timer statistics are backed by the same histogram type
+    kitpp::stats::enable_aggregation(false);
+    for (int i = 0; i < 5000; ++i) {
+        KITPP_SCOPE_TIMER("handle_request");
+        total += handle_request(i);
+    }
+    kitpp::stats::print_report();
+    kitpp::stats::site_histogram("handle_request").write_percentiles(std::clog, 1000.0);
+
+    KITPP_LOG_INFOF("total = {:.3}", total);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <kitpp/kitpp.hpp>
+#include <kitpp/math/dispatch.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace kitpp::math;
+
+// Runs dot/axpy under every variant this CPU supports. Odd lengths and
+// offset pointers exercise the unaligned paths and the tails.
+// KITPP_MATH_ISA=scalar|avx2|avx512 caps the default choice.
+int main()
+{
+    KITPP_LOG_INFOF("Best kernels for this CPU: {}, in use: {}", isa_name(detect_isa()), isa_name(active_isa()));
+
+    const std::size_t n = 10'000'003;
+    std::vector<double> a(n + 1), b(n + 1);
+    for (std::size_t i = 0; i < n + 1; ++i) {
+        a[i] = std::sin(static_cast<double>(i));
+        b[i] = std::cos(static_cast<double>(i));
+    }
+    const double* pa = a.data() + 1; // Deliberately not 32-byte aligned
+    const double* pb = b.data() + 1;
+
+    set_isa(Isa::Scalar);
+    const double reference = dot(pa, pb, n);
+    std::vector<double> y_reference(b.begin() + 1, b.end());
+    axpy(0.5, pa, y_reference.data(), n);
+
+    for (Isa isa : { Isa::Scalar, Isa::Avx2, Isa::Avx512 }) {
+        if (!set_isa(isa)) {
+            KITPP_LOG_INFOF("{}: not supported here", isa_name(isa));
+            continue;
+        }
+        double d = 0.0;
+        {
+            KITPP_SCOPE_TIMER(std::string("dot ") + isa_name(isa));
+            for (int r = 0; r < 10; ++r) {
+                d = dot(pa, pb, n);
+            }
+        }
+        std::vector<double> y(b.begin() + 1, b.end());
+        {
+            KITPP_SCOPE_TIMER(std::string("axpy ") + isa_name(isa));
+            axpy(0.5, pa, y.data(), n);
+        }
+        double max_err = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            max_err = std::max(max_err, std::fabs(y[i] - y_reference[i]));
+        }
+        KITPP_LOG_INFOF("{}: dot={:.10} (scalar {:.10}), axpy max |diff|={}", isa_name(isa), d, reference, max_err);
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main()
+{
+    namespace metrics = kitpp::metrics;
+
+    // Registered once; the handles are cheap to copy and update
+    auto requests = metrics::counter("app_requests", "Requests handled", { { "kind", "compute" } });
+    auto queue = metrics::gauge("app_queue_depth", "Items waiting");
+    auto latency = metrics::histogram("app_request_seconds", "Request latency",
+        metrics::exponential_buckets(1e-6, 10.0, 6));
+
+    // Existing kitpp data, read at every export
+    kitpp::ThroughputLogger items("items");
+    kitpp::stats::enable_aggregation(false);
+    auto r1 = metrics::expose(items);
+    auto r2 = metrics::expose_timer_stats();
+    auto r3 = metrics::expose_process();
+
+    metrics::start_textfile_exporter("kitpp_metrics.prom", std::chrono::milliseconds(100));
+    const int port = metrics::start_http_endpoint(0);
+    KITPP_LOG_INFOF("metrics at http://127.0.0.1:{}/metrics", port);
+
+    double acc = 0.0;
+    for (int round = 0; round < 50; ++round) {
+        queue.set(50 - round);
+        KITPP_SCOPE_TIMER("request");
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 20000 * (1 + round % 5); ++i) {
+            acc += std::sqrt(static_cast<double>(i));
+            items.add();
+        }
+        requests.inc();
+        latency.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    metrics::stop_textfile_exporter();
+    metrics::stop_http_endpoint();
+    KITPP_LOG_INFOF("acc = {:.3}, wrote kitpp_metrics.prom", acc);
+    metrics::write(std::cout);
+
+    // Unregistering the collector drops the series it created
+    r2.reset();
+    if (metrics::render().find("kitpp_timer_seconds") != std::string::npos) {
+        KITPP_LOG_ERROR("kitpp_timer_seconds still exported after its registration was reset");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+#include <vector>
+
+// Work per element grows with i, so a static schedule leaves the
+// low-numbered threads idle at the barrier
+double cost(int i)
+{
+    double acc = 0.0;
+    for (int k = 0; k < i / 8; ++k) {
+        acc += std::sqrt(static_cast<double>(k + i));
+    }
+    return acc;
+}
+
+int main()
+{
+    const int n = 20000;
+    std::vector<double> out(n);
+
+#pragma omp parallel
+    {
+        KITPP_OMP_REGION_TIMER("triangular, schedule(static)");
+#pragma omp for schedule(static) nowait
+        for (int i = 0; i < n; ++i) {
+            out[i] = cost(i);
+        }
+    }
+
+#pragma omp parallel
+    {
+        KITPP_OMP_REGION_TIMER("triangular, schedule(dynamic, 64)");
+#pragma omp for schedule(dynamic, 64) nowait
+        for (int i = 0; i < n; ++i) {
+            out[i] = cost(i);
+        }
+    }
+
+    // Per-thread busy time, CPU and wait are logged at debug level
+    kitpp::log::set_level(kitpp::log::Level::Debug);
+#pragma omp parallel
+    {
+        KITPP_OMP_REGION_TIMER("triangular, schedule(guided)");
+#pragma omp for schedule(guided) nowait
+        for (int i = 0; i < n; ++i) {
+            out[i] = cost(i);
+        }
+    }
+
+    KITPP_LOG_INFOF("out[n-1] = {:.3}", out[n - 1]);
+    return 0;
+}
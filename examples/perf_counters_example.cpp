@@ -0,0 +1,45 @@
+#include <kitpp/kitpp.hpp>
+#include <kitpp/math/dispatch.hpp> // detect_isa
+#include <kitpp/math/dot_prod.hpp>
+
+using namespace kitpp::math;
+
+int main()
+{
+    // The AVX kernels need AVX2 + FMA; without them only dot_scalar runs
+    const bool avx2 = detect_isa() >= Isa::Avx2;
+    if (!avx2) {
+        KITPP_LOG_WARN("AVX2 not available on this CPU, skipping the AVX kernels");
+    }
+
+    // Small (cache resident) vs large (memory bound) inputs: compare IPC
+    // and LLC misses per element between the two
+    for (std::size_t n : { std::size_t(1) << 12, std::size_t(1) << 24 }) {
+        kitpp::memory::AlignedBuffer<double> a(n, 1.0); // The AVX kernels use aligned loads
+        kitpp::memory::AlignedBuffer<double> b(n, 2.0);
+        const std::size_t reps = (std::size_t(1) << 26) / n;
+        double sum = 0.0;
+
+        {
+            KITPP_PERF_SCOPE_N("dot_scalar", n * reps);
+            for (std::size_t r = 0; r < reps; ++r) {
+                sum += dot_scalar(a, b);
+            }
+        }
+        if (avx2) {
+            KITPP_MEASURE_PERF_SCOPE("dot_avx_zen2", n * reps);
+            for (std::size_t r = 0; r < reps; ++r) {
+                sum += dot_avx_zen2(a, b);
+            }
+        }
+        if (avx2) {
+            // Explicit event list
+            KITPP_PERF_SCOPE("dot_avx_4x", kitpp::perf::Event::TaskClock, kitpp::perf::Event::PageFaults);
+            for (std::size_t r = 0; r < reps; ++r) {
+                sum += dot_avx_4x(a, b);
+            }
+        }
+        KITPP_LOG_INFOF("n = {}, sum = {:.1}", n, sum);
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+
+double leaf(int n)
+{
+    KITPP_SCOPE_TIMER("leaf");
+    double acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += std::sin(i * 0.001);
+    }
+    return acc;
+}
+
+double middle(int n)
+{
+    KITPP_SCOPE_TIMER("middle");
+    double acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += std::cos(i * 0.001); // Exclusive work
+    }
+    return acc + leaf(n) + leaf(n / 2);
+}
+
+double solve()
+{
+    KITPP_SCOPE_TIMER("solve");
+    double acc = 0.0;
+    for (int i = 0; i < 50; ++i) {
+        acc += middle(20000);
+    }
+    acc += leaf(100000);
+    return acc;
+}
+
+int main()
+{
+    // Call tree printed at exit, folded stacks for flamegraph.pl / speedscope
+    kitpp::profile::enable_profiling(true, "profile.folded");
+    kitpp::stats::enable_aggregation(false); // No line per scope
+
+    double total = solve();
+
+    // Worker threads have no open parent scope: these become extra roots
+#pragma omp parallel for reduction(+ : total)
+    for (int i = 0; i < 64; ++i) {
+        total += middle(5000);
+    }
+
+    KITPP_LOG_INFOF("total = {:.3}", total);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    // Sample every 10 ms; resource_samples.csv is written by stop_sampling()
+    kitpp::resource::start_sampling(std::chrono::milliseconds(10));
+
+    std::vector<std::vector<double>> blocks;
+    {
+        KITPP_SCOPE_TIMER("grow");
+        for (int i = 0; i < 8; ++i) {
+            blocks.emplace_back(std::size_t(4) << 20, 1.0); // 32 MiB each
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        }
+    }
+    {
+        KITPP_SCOPE_TIMER("shrink");
+        while (!blocks.empty()) {
+            blocks.pop_back();
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        }
+    }
+
+    kitpp::resource::stop_sampling();
+
+    const auto samples = kitpp::resource::sampler().samples();
+    std::printf("%zu samples (%zu dropped) written to resource_samples.csv\n", samples.size(),
+        kitpp::resource::sampler().dropped());
+    for (std::size_t i = 0; i < samples.size(); i += 4) {
+        const auto& s = samples[i];
+        std::printf("%8.1f ms  rss %7lld kB  anon %7lld kB  minflt %7lld  user %6lld us  sys %6lld us\n",
+            static_cast<double>(s.elapsed_ns) / 1e6, static_cast<long long>(s.rss_kb),
+            static_cast<long long>(s.anon_kb), static_cast<long long>(s.minor_faults),
+            static_cast<long long>(s.user_us), static_cast<long long>(s.sys_us));
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+double hot_kernel(int i)
+{
+    // Only one call in 1000 is timed and printed
+    KITPP_SCOPE_TIMER_SAMPLED("hot_kernel", 1000);
+    return std::sqrt(static_cast<double>(i));
+}
+
+int main()
+{
+    double acc = 0.0;
+    for (int i = 0; i < 5000; ++i) {
+        acc += hot_kernel(i);
+
+        KITPP_LOG_FIRST_N(3, "first iterations: " + std::to_string(i));
+        KITPP_LOG_EVERY_N(2000, "progress: iteration " + std::to_string(i));
+    }
+
+    // Time-based limit: prints roughly every 20 ms while the loop spins
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    long long spins = 0;
+    while (std::chrono::steady_clock::now() < end) {
+        ++spins;
+        KITPP_LOG_EVERY_MS(20, "still spinning");
+    }
+
+    KITPP_LOG_INFOF("acc = {:.3}, spins = {}", acc, spins);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+int main()
+{
+    kitpp::ThroughputLogger items("items");
+    items.set_ewma_window(std::chrono::milliseconds(500));
+    items.start_reporter(std::chrono::milliseconds(200));
+
+    // Every item is counted from inside the parallel loop
+    double acc = 0.0;
+    for (int phase = 0; phase < 4; ++phase) {
+        const int work = phase % 2 == 0 ? 200 : 2000; // Alternate fast and slow phases
+#pragma omp parallel for reduction(+ : acc) schedule(dynamic, 256)
+        for (int i = 0; i < 200000; ++i) {
+            for (int k = 0; k < work; k += 100) {
+                acc += std::sqrt(static_cast<double>(i + k));
+            }
+            items.add();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    }
+
+    items.stop_reporter();
+    items.report();
+    KITPP_LOG_INFOF("counted {} items, acc = {:.3}", items.total(), acc);
+
+    const auto& rates = items.rate_histogram();
+    KITPP_LOG_INFOF("interval rates over {} reports: min {} p50 {} max {} ops/sec",
+        rates.count(), rates.min(), rates.value_at_percentile(50.0), rates.max());
+    return 0;
+}
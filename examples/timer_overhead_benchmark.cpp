@@ -0,0 +1,110 @@
+#include <kitpp/kitpp.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+// Cost each timer macro adds around an empty scope, per use. Console
+// output is muted (level above info) so the numbers are the timer itself,
+// not the terminal. Run with KITPP_CLOCK=steady to compare clocks.
+
+volatile std::uint64_t g_sink = 0;
+
+template <typename Body>
+double ns_per_iter(int iters, Body&& body)
+{
+    for (int i = 0; i < iters / 10; ++i) { // Warm up
+        body(i);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+        body(i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+void report(const char* name, double ns)
+{
+    KITPP_LOG_WARNF("{}: {:.1} ns", name, ns);
+}
+
+int main()
+{
+    using namespace kitpp;
+    constexpr int iters = 200000;
+
+    // Bias: what an empty scope reports, per clock (shared by every timer
+    // type on that clock; the differences between macros are measured below)
+    overhead::calibrate_all();
+    KITPP_LOG_WARNF("empty-interval bias: steady {} ns, omp {} ns, tsc {} ns (tsc reliable: {})",
+        overhead::bias_ns<clocks::SteadyClock>(), overhead::bias_ns<clocks::OmpClock>(),
+        overhead::bias_ns<clocks::TscClock>(), clocks::TscClock::reliable());
+
+    log::set_level(log::Level::Warn); // Mute the per-scope lines
+    speed_tracker().set_path("timer_overhead_benchmark.csv");
+
+    report("baseline (empty loop)", ns_per_iter(iters, [](int i) { g_sink += i; }));
+    report("KITPP_SCOPE_TIMER", ns_per_iter(iters, [](int i) {
+        KITPP_SCOPE_TIMER("bench");
+        g_sink += i;
+    }));
+    report("KITPP_SCOPE_TIMER_SAMPLED (1/100)", ns_per_iter(iters, [](int i) {
+        KITPP_SCOPE_TIMER_SAMPLED("bench", 100);
+        g_sink += i;
+    }));
+    report("KITPP_MEASURE_SCOPE (CSV)", ns_per_iter(iters, [](int i) {
+        KITPP_MEASURE_SCOPE("bench");
+        g_sink += i;
+    }));
+    report("CREATE_MANUAL_TIMER start/stop", ns_per_iter(iters, [](int i) {
+        auto t = CREATE_MANUAL_TIMER("bench");
+        t.start();
+        g_sink += i;
+        t.stop();
+    }));
+    report("KITPP_MEASURE_MANUAL start/stop (CSV)", ns_per_iter(iters, [](int i) {
+        auto t = KITPP_MEASURE_MANUAL("bench");
+        t.start();
+        g_sink += i;
+        t.stop();
+    }));
+    report("KITPP_PERF_SCOPE", ns_per_iter(iters / 10, [](int i) {
+        KITPP_PERF_SCOPE("bench");
+        g_sink += i;
+    }));
+
+    stats::enable_aggregation(false);
+    report("KITPP_SCOPE_TIMER (aggregating)", ns_per_iter(iters, [](int i) {
+        KITPP_SCOPE_TIMER("bench");
+        g_sink += i;
+    }));
+    profile::enable_profiling(false);
+    report("KITPP_SCOPE_TIMER (aggregating+profile)", ns_per_iter(iters, [](int i) {
+        KITPP_SCOPE_TIMER("bench");
+        g_sink += i;
+    }));
+    profile::disable_profiling();
+    stats::disable_aggregation();
+
+    report("KITPP_OMP_REGION_TIMER (per region)", ns_per_iter(iters / 100, [](int i) {
+#pragma omp parallel
+        {
+            KITPP_OMP_REGION_TIMER("bench");
+            volatile std::uint64_t local_sink = 0; // Per thread: g_sink would race
+            local_sink += static_cast<std::uint64_t>(i);
+        }
+    }));
+
+    // What an empty scope reports, with and without bias subtraction
+    stats::reset();
+    stats::enable_aggregation(false);
+    for (int i = 0; i < iters; ++i) {
+        KITPP_SCOPE_TIMER("empty scope (raw)");
+    }
+    overhead::enable_subtraction();
+    for (int i = 0; i < iters; ++i) {
+        KITPP_SCOPE_TIMER("empty scope (bias subtracted)");
+    }
+    stats::print_report();
+    return 0;
+}
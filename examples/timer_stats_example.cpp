@@ -0,0 +1,47 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+#include <vector>
+
+double small_kernel(int n)
+{
+    KITPP_SCOPE_TIMER("small_kernel");
+    double acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += std::sin(i * 0.001);
+    }
+    return acc;
+}
+
+double large_kernel()
+{
+    KITPP_SCOPE_TIMER("large_kernel");
+    return small_kernel(20000) + small_kernel(20000);
+}
+
+int main()
+{
+    // One summary table at exit instead of a line per scope
+    kitpp::stats::enable_aggregation();
+
+    double total = 0.0;
+#pragma omp parallel for reduction(+ : total)
+    for (int i = 0; i < 20000; ++i) {
+        total += small_kernel(50 + i % 200);
+    }
+
+    auto timer = CREATE_MANUAL_TIMER("manual_phase");
+    for (int i = 0; i < 100; ++i) {
+        timer.restart();
+        total += large_kernel();
+    }
+    timer.stop();
+
+    KITPP_LOG_INFOF("total = {:.3}", total);
+
+    // A report can also be printed on demand
+    kitpp::stats::print_report();
+    kitpp::stats::reset();
+    total += large_kernel();
+    return total > 0.0 ? 0 : 1;
+}
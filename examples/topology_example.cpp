@@ -0,0 +1,40 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using namespace kitpp::topology;
+
+int main()
+{
+    const Topology& topo = get();
+    KITPP_LOG_INFO("Topology: " + topo.describe());
+
+    for (const auto& c : topo.caches) {
+        std::printf("L%d %-11s %8zu KiB  line %zu B  shared by %zu CPU(s)\n", c.level, c.type.c_str(),
+            c.size_bytes / 1024, c.line_bytes, c.shared_cpus.size());
+    }
+
+    // A per-thread working set that fits in half of this thread's L2 share
+    const std::size_t l2_per_thread = topo.cache_size(2) / static_cast<std::size_t>(topo.cache_sharing(2));
+    const std::size_t block = l2_per_thread > 0 ? l2_per_thread / 2 / sizeof(double) : 4096;
+    std::printf("Block size for two streams in L2: %zu doubles\n", block);
+
+    for (Policy p : { Policy::Compact, Policy::Scatter, Policy::OnePerCore }) {
+        std::printf("%-13s", policy_name(p));
+        for (int cpu : placement(p, 8)) {
+            std::printf(" %d", cpu);
+        }
+        std::printf("\n");
+    }
+
+    const int pinned = pin_omp_team(Policy::OnePerCore);
+    KITPP_LOG_INFOF("Pinned {} OpenMP thread(s), one per physical core", pinned);
+#pragma omp parallel
+    {
+        KITPP_LOG_INFOF("OpenMP thread {} runs on CPU {}", kitpp::omp_tid(), kitpp::cpu_index());
+    }
+
+    unpin_current_thread();
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <kitpp/kitpp.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+double chunk_work(int n)
+{
+    KITPP_SCOPE_TIMER("chunk_work");
+    double acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += std::sqrt(static_cast<double>(i));
+    }
+    return acc;
+}
+
+int main()
+{
+    // Open trace.json in chrome://tracing or ui.perfetto.dev
+    kitpp::trace::start_tracing("trace.json");
+    kitpp::stats::enable_aggregation(false); // No console line per scope
+
+#pragma omp parallel
+    {
+        // Shown in the viewer, in top -H / perf and in KITPP_LOG_THREAD_CONTEXT
+        const int t = kitpp::omp_tid();
+        kitpp::set_thread_name(t <= 0 ? std::string("main") : "omp-worker-" + std::to_string(t));
+        kitpp::trace::reserve_thread(); // Allocate buffers outside the timed loop
+    }
+    kitpp::print_threads(std::clog);
+
+    double total = 0.0;
+    auto phase = CREATE_MANUAL_TIMER("pipeline");
+    for (int step = 0; step < 4; ++step) {
+        phase.restart();
+        // Uneven chunks so the idle threads are visible in the viewer
+#pragma omp parallel for schedule(dynamic) reduction(+ : total)
+        for (int i = 0; i < 64; ++i) {
+            total += chunk_work(20000 + 3000 * (i % 7));
+        }
+    }
+    phase.stop();
+
+    KITPP_LOG_INFOF("total = {:.3}", total);
+    KITPP_LOG_THREAD_CONTEXT("after the parallel steps");
+    kitpp::trace::stop_tracing();
+    return 0;
+}
@@ -50,6 +50,10 @@ int main()
         tlog.record(items_processed);
     }
 
+    // Format-style logging: arguments are only formatted if the level is enabled
+    KITPP_LOG_INFOF("Processed {} items, rate {:.2} items/ms", items_processed, items_processed / 240.0);
+    KITPP_LOG_DEBUG("Hidden unless KITPP_LOG_LEVEL=debug: " + std::to_string(items_processed));
+
     int my_var = 42;
     KITPP_LOG_VAR(my_var);
 
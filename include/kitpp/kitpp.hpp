@@ -5,7 +5,25 @@
 #include "log/scope_timer.hpp"
 #include "log/throughput_logger.hpp"
 #include "log/manual_timer.hpp"
+#include "log/histogram.hpp"
+#include "log/timer_stats.hpp"
+#include "log/scope_profiler.hpp"
+#include "log/trace_sink.hpp"
+#include "log/perf_scope.hpp"
+#include "log/resource_scope.hpp"
+#include "log/omp_region_timer.hpp"
+#include "log/timer_overhead.hpp"
+#include "log/metrics.hpp"
+#include "log/memory.hpp"
+#include "log/alloc_tracker.hpp"
+#include "memory/aligned_buffer.hpp"
+#include "memory/arena.hpp"
+#include "memory/pool.hpp"
+#include "sys/clock.hpp"
 #include "sys/platform.hpp"
+#include "sys/thread_info.hpp"
+#include "sys/resource_sampler.hpp"
+#include "sys/topology.hpp"
 #include "sys/version.hpp"
 
 namespace kitpp {
@@ -2,76 +2,134 @@
 #define KITPP_TIMER_COMMON_HPP
 
 #include <chrono>
-#include <fstream>
-#include <iomanip>
-#include <mutex>
-#include <sstream>
+#include <cstddef>
+#include <ctime>
 #include <string>
 #include <string_view>
 
+#include "csv_sink.hpp"
+#include "format.hpp"
+
 namespace kitpp::detail::time {
 
-    // Gets current wall-clock time for the "Timestamp" column
-    inline std::string get_current_timestamp()
+    // Per-thread cache of the "YYYY-mm-dd HH:MM:SS." prefix; localtime is
+    // only called when the second changes
+    struct TimestampCache {
+        long long second = -1;
+        std::size_t prefix_len = 0;
+        char text[40] = {};
+    };
+
+    // Wall-clock time in ms since the epoch as "YYYY-mm-dd HH:MM:SS.mmm"
+    // (local time). The view points into a thread-local buffer, valid until
+    // the next call.
+    inline std::string_view timestamp_view(long long now_ms)
     {
-        using namespace std::chrono;
-        auto now = system_clock::now();
-        auto in_time_t = system_clock::to_time_t(now);
-        auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+        thread_local TimestampCache cache;
 
-        std::stringstream ss;
-        std::tm tm_buf;
+        long long sec = now_ms / 1000;
+        if (sec != cache.second) {
+            std::time_t in_time_t = static_cast<std::time_t>(sec);
+            std::tm tm_buf;
 #if defined(_WIN32)
-        localtime_s(&tm_buf, &in_time_t);
+            localtime_s(&tm_buf, &in_time_t);
 #else
-        localtime_r(&in_time_t, &tm_buf);
+            localtime_r(&in_time_t, &tm_buf);
 #endif
+            cache.prefix_len = std::strftime(cache.text, sizeof(cache.text) - 4, "%Y-%m-%d %H:%M:%S.", &tm_buf);
+            cache.second = sec;
+        }
+        char* end = kitpp::log::detail::write_padded(cache.text + cache.prefix_len, static_cast<unsigned long long>(now_ms % 1000), 3);
+        return std::string_view(cache.text, static_cast<std::size_t>(end - cache.text));
+    }
 
-        ss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-        ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-        return ss.str();
+    // Gets current wall-clock time for the "Timestamp" column.
+    // The view points into a thread-local buffer, valid until the next call.
+    inline std::string_view timestamp_view()
+    {
+        using namespace std::chrono;
+        return timestamp_view(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    }
+
+    inline std::string get_current_timestamp()
+    {
+        return std::string(timestamp_view());
+    }
+
+    // "HH:MM:SS.mmm" into a thread-local buffer, valid until the next call
+    inline std::string_view format_duration_view(long long duration_us)
+    {
+        thread_local char buf[40];
+        unsigned long long us = duration_us < 0 ? 0 : static_cast<unsigned long long>(duration_us);
+        unsigned long long ms = us / 1000;
+        unsigned long long s = ms / 1000;
+        unsigned long long m = s / 60;
+        unsigned long long h = m / 60;
+
+        char* p = kitpp::log::detail::write_padded(buf, h, 2);
+        *p++ = ':';
+        p = kitpp::log::detail::write_padded(p, m % 60, 2);
+        *p++ = ':';
+        p = kitpp::log::detail::write_padded(p, s % 60, 2);
+        *p++ = '.';
+        p = kitpp::log::detail::write_padded(p, ms % 1000, 3);
+        return std::string_view(buf, static_cast<std::size_t>(p - buf));
     }
 
     inline std::string format_duration(long long duration_us)
     {
-        using namespace std::chrono;
-        auto d = microseconds(duration_us);
-        auto h = duration_cast<hours>(d);
-        d -= h;
-        auto m = duration_cast<minutes>(d);
-        d -= m;
-        auto s = duration_cast<seconds>(d);
-        d -= s;
-        auto ms = duration_cast<milliseconds>(d);
-
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(2) << h.count() << ":"
-           << std::setfill('0') << std::setw(2) << m.count() << ":"
-           << std::setfill('0') << std::setw(2) << s.count() << "."
-           << std::setfill('0') << std::setw(3) << ms.count();
-        return ss.str();
+        return std::string(format_duration_view(duration_us));
+    }
+
+    // Shared sink behind KITPP_MEASURE_SCOPE / KITPP_MEASURE_MANUAL
+    inline kitpp::log::CsvSink& speed_sink()
+    {
+        static kitpp::log::CsvSink sink("speed_tracker.csv",
+            "Timestamp,Scope,File,Function,Line,Duration_us,Duration_Seconds,Duration_Pretty,Duration_ns");
+        return sink;
     }
 
+    // Duration_ns is the timer clock's full resolution; the other duration
+    // columns are kept as before for existing scripts. A speed_tracker.csv
+    // from before Duration_ns is moved to speed_tracker.csv.old (CsvSink).
     inline void log_time_to_file(const std::string_view scope,
-        long long duration_us, const char* file, int line,
+        long long duration_ns, const char* file, int line,
         const char* func)
     {
-        static std::mutex log_mutex;
-        std::lock_guard<std::mutex> lock(log_mutex);
+        const long long duration_us = duration_ns / 1000;
+        speed_sink().append_row([&](std::string& out) {
+            using kitpp::log::detail::append_value;
+            out += timestamp_view();
+            out += ',';
+            out += scope;
+            out += ',';
+            out += file;
+            out += ',';
+            out += func;
+            out += ',';
+            append_value(out, line, {});
+            out += ',';
+            append_value(out, duration_us, {});
+            out += ',';
+            append_value(out, static_cast<double>(duration_us) / 1000000.0, ".6");
+            out += ',';
+            out += format_duration_view(duration_us);
+            out += ',';
+            append_value(out, duration_ns, {});
+            out += '\n';
+        });
+    }
 
-        std::ofstream outfile("speed_tracker.csv", std::ios::app);
+} // namespace kitpp::detail::time
 
-        if (outfile.tellp() == 0) {
-            outfile << "Timestamp,Scope,File,Function,Line,Duration_us,Duration_Seconds,Duration_Pretty\n";
-        }
+namespace kitpp {
 
-        outfile << get_current_timestamp() << ","
-                << scope << "," << file << "," << func << "," << line << ","
-                << duration_us << ","
-                << (static_cast<double>(duration_us) / 1000000.0) << ","
-                << format_duration(duration_us) << "\n";
-    }
+// The speed_tracker.csv sink, e.g. speed_tracker().set_path("run42/speed.csv")
+inline log::CsvSink& speed_tracker()
+{
+    return detail::time::speed_sink();
+}
 
-} // namespace kitpp::detail::time
+} // namespace kitpp
 
 #endif // KITPP_TIMER_COMMON_HPP
\ No newline at end of file
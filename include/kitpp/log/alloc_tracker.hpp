@@ -0,0 +1,532 @@
+#ifndef KITPP_ALLOC_TRACKER_HPP
+#define KITPP_ALLOC_TRACKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../sys/platform.hpp"
+#include "csv_sink.hpp"
+#include "format.hpp"
+#include "TimerCommon.hpp"
+
+namespace kitpp::memory {
+
+// --- Allocation Tracking ---
+// Allocations made through TrackingAllocator<T>, or through global
+// operator new once KITPP_TRACK_GLOBAL_ALLOCATIONS() is placed in one
+// source file, are counted against the innermost KITPP_MEM_SCOPE of the
+// allocating thread (scopes nest: "request/parse"). Each allocation
+// carries a 32-byte header with its size, scope and allocating thread, so
+// a free is credited to the scope and the thread that allocated, whichever
+// thread frees it. Counters are per thread and summed by the report; only
+// 'live' takes atomic read-modify-writes (a free from another thread
+// decrements it), the rest are plain relaxed stores by the owner. A
+// thread's peak is the most live bytes it had allocated at once in the
+// scope; the report shows the largest of these, not a scope-wide peak.
+// The global hook records only while enable_alloc_tracking() is on;
+// TrackingAllocator always records.
+
+namespace detail {
+
+    constexpr std::uint32_t alloc_max_scopes = 4096;
+    constexpr std::uint32_t alloc_block_scopes = 64;
+    constexpr std::uint32_t alloc_untracked = std::numeric_limits<std::uint32_t>::max();
+
+    struct ScopeCounters {
+        std::atomic<std::uint64_t> allocs;
+        std::atomic<std::uint64_t> frees;
+        std::atomic<std::uint64_t> bytes_allocated;
+        std::atomic<std::uint64_t> bytes_freed;
+        std::atomic<std::int64_t> live; // Bytes this thread allocated that are not freed yet
+        std::atomic<std::int64_t> peak; // Highest 'live'; only the owner writes it
+    };
+
+    // Only the owning thread writes (except 'live'); the report reads
+    template <typename T, typename U>
+    inline void bump(std::atomic<T>& a, U n)
+    {
+        a.store(a.load(std::memory_order_relaxed) + static_cast<T>(n), std::memory_order_relaxed);
+    }
+
+    // Allocated with malloc and never freed, so frees during thread or
+    // process teardown still have somewhere to go. Linked into a global
+    // list without locks.
+    struct ThreadAllocStats {
+        std::atomic<ScopeCounters*> blocks[alloc_max_scopes / alloc_block_scopes];
+        ThreadAllocStats* next;
+
+        ScopeCounters& at(std::uint32_t scope)
+        {
+            auto& slot = blocks[scope / alloc_block_scopes];
+            ScopeCounters* block = slot.load(std::memory_order_acquire);
+            if (block == nullptr) {
+                void* mem = std::malloc(alloc_block_scopes * sizeof(ScopeCounters));
+                if (mem == nullptr) {
+                    std::abort();
+                }
+                block = static_cast<ScopeCounters*>(mem);
+                for (std::uint32_t i = 0; i < alloc_block_scopes; ++i) {
+                    new (block + i) ScopeCounters {};
+                }
+                slot.store(block, std::memory_order_release);
+            }
+            return block[scope % alloc_block_scopes];
+        }
+
+        const ScopeCounters* find(std::uint32_t scope) const
+        {
+            const ScopeCounters* block = blocks[scope / alloc_block_scopes].load(std::memory_order_acquire);
+            return block != nullptr ? &block[scope % alloc_block_scopes] : nullptr;
+        }
+    };
+
+    inline std::atomic<ThreadAllocStats*>& thread_list()
+    {
+        static std::atomic<ThreadAllocStats*> head { nullptr };
+        return head;
+    }
+
+    inline ThreadAllocStats& thread_alloc_stats()
+    {
+        thread_local ThreadAllocStats* stats = nullptr;
+        if (stats == nullptr) {
+            void* mem = std::malloc(sizeof(ThreadAllocStats));
+            if (mem == nullptr) {
+                std::abort();
+            }
+            stats = new (mem) ThreadAllocStats {};
+            auto& head = thread_list();
+            stats->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(stats->next, stats, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+        return *stats;
+    }
+
+    // --- Scope names ---
+    // Node 0 is "(unscoped)"; a node is (parent node, name) so nested
+    // scopes report as paths. Fixed table, interned under a mutex.
+
+    struct ScopeNode {
+        std::uint32_t parent;
+        const char* name;
+    };
+
+    struct ScopeTable {
+        ScopeNode nodes[alloc_max_scopes] { { 0, "(unscoped)" } };
+        std::atomic<std::uint32_t> count { 1 };
+        std::mutex mutex;
+    };
+
+    inline ScopeTable& scope_table()
+    {
+        static ScopeTable table;
+        return table;
+    }
+
+    inline std::uint32_t intern_scope(std::uint32_t parent, const char* name)
+    {
+        ScopeTable& t = scope_table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        const std::uint32_t n = t.count.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 1; i < n; ++i) {
+            if (t.nodes[i].parent == parent && std::strcmp(t.nodes[i].name, name) == 0) {
+                return i;
+            }
+        }
+        if (n == alloc_max_scopes) {
+            return parent; // Table full: charge the enclosing scope
+        }
+        t.nodes[n] = { parent, name };
+        t.count.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    inline std::uint32_t& current_scope()
+    {
+        thread_local std::uint32_t scope = 0;
+        return scope;
+    }
+
+    // Set while the tracker itself runs, so its own allocations are not counted
+    inline bool& in_tracker()
+    {
+        thread_local bool busy = false;
+        return busy;
+    }
+
+    // One per KITPP_MEM_SCOPE call site; remembers the node for the last parent
+    class ScopeSite {
+    public:
+        explicit ScopeSite(const char* name)
+            : name_(name)
+        {
+        }
+
+        std::uint32_t node(std::uint32_t parent)
+        {
+            const std::uint64_t cached = cache_.load(std::memory_order_relaxed);
+            if (cached != 0 && static_cast<std::uint32_t>(cached >> 32) == parent + 1) {
+                return static_cast<std::uint32_t>(cached);
+            }
+            in_tracker() = true;
+            const std::uint32_t id = intern_scope(parent, name_);
+            in_tracker() = false;
+            cache_.store((static_cast<std::uint64_t>(parent) + 1) << 32 | id, std::memory_order_relaxed);
+            return id;
+        }
+
+    private:
+        const char* name_;
+        std::atomic<std::uint64_t> cache_ { 0 };
+    };
+
+    inline std::atomic<bool>& global_tracking()
+    {
+        static std::atomic<bool> on { false };
+        return on;
+    }
+
+    struct alignas(16) AllocHeader {
+        std::size_t size;
+        ThreadAllocStats* owner; // Allocating thread (never freed)
+        std::uint32_t scope;     // alloc_untracked if not recorded
+        std::uint32_t offset;    // From the malloc'ed block to the user pointer
+    };
+    static_assert(sizeof(AllocHeader) == 32, "tracked_malloc reserves 32 bytes for the header");
+
+    // Charges the allocation to this thread and the current scope, or
+    // marks the header untracked
+    inline void note_alloc(AllocHeader& h, std::size_t bytes, bool always)
+    {
+        h.owner = nullptr;
+        h.scope = alloc_untracked;
+        if (in_tracker() || (!always && !global_tracking().load(std::memory_order_relaxed))) {
+            return;
+        }
+        in_tracker() = true;
+        const std::uint32_t scope = current_scope();
+        ThreadAllocStats& stats = thread_alloc_stats();
+        ScopeCounters& c = stats.at(scope);
+        bump(c.allocs, 1);
+        bump(c.bytes_allocated, bytes);
+        const std::int64_t live = c.live.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed)
+            + static_cast<std::int64_t>(bytes);
+        if (live > c.peak.load(std::memory_order_relaxed)) {
+            c.peak.store(live, std::memory_order_relaxed);
+        }
+        h.owner = &stats;
+        h.scope = scope;
+        in_tracker() = false;
+    }
+
+    // The free is counted by this thread; the bytes leave the allocating
+    // thread's 'live', so its peak stays the real high-water mark
+    inline void note_free(const AllocHeader& h)
+    {
+        const bool nested = in_tracker();
+        in_tracker() = true;
+        ScopeCounters& c = thread_alloc_stats().at(h.scope);
+        bump(c.frees, 1);
+        bump(c.bytes_freed, h.size);
+        h.owner->at(h.scope).live.fetch_sub(static_cast<std::int64_t>(h.size), std::memory_order_relaxed);
+        in_tracker() = nested;
+    }
+
+    // malloc + header; align 0 means the default new alignment
+    inline void* tracked_malloc(std::size_t size, std::size_t align, bool always)
+    {
+        align = std::max<std::size_t>(align, alignof(AllocHeader));
+        // Room for the header, keeping the user pointer aligned (both powers of two)
+        const std::size_t offset = std::max(align, sizeof(AllocHeader));
+        void* raw = nullptr;
+        if (align <= alignof(std::max_align_t)) {
+            raw = std::malloc(size + offset);
+        } else {
+            raw = std::aligned_alloc(align, (size + offset + align - 1) / align * align);
+        }
+        if (raw == nullptr) {
+            return nullptr;
+        }
+        char* user = static_cast<char*>(raw) + offset;
+        auto* h = reinterpret_cast<AllocHeader*>(user) - 1;
+        h->size = size;
+        h->offset = static_cast<std::uint32_t>(offset);
+        note_alloc(*h, size, always);
+        return user;
+    }
+
+    inline void tracked_free(void* p) noexcept
+    {
+        if (p == nullptr) {
+            return;
+        }
+        auto* h = static_cast<AllocHeader*>(p) - 1;
+        if (h->scope != alloc_untracked) {
+            note_free(*h);
+        }
+        std::free(static_cast<char*>(p) - h->offset);
+    }
+
+    inline void* tracked_new(std::size_t size, std::size_t align = 0)
+    {
+        void* p = tracked_malloc(size, align, false);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+} // namespace detail
+
+// RAII: allocations on this thread are charged to 'name' (nested in the
+// enclosing scope) until the end of the C++ scope
+class MemScope {
+public:
+    explicit MemScope(detail::ScopeSite& site)
+        : prev_(detail::current_scope())
+    {
+        detail::current_scope() = site.node(prev_);
+    }
+    ~MemScope() { detail::current_scope() = prev_; }
+
+    MemScope(const MemScope&) = delete;
+    MemScope& operator=(const MemScope&) = delete;
+
+private:
+    std::uint32_t prev_;
+};
+
+// --- TrackingAllocator ---
+// Standard allocator that records every allocation, e.g.
+// std::vector<Event, kitpp::memory::TrackingAllocator<Event>>
+template <typename T>
+class TrackingAllocator {
+public:
+    using value_type = T;
+
+    TrackingAllocator() noexcept = default;
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void* p = detail::tracked_malloc(n * sizeof(T), alignof(T), true);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { detail::tracked_free(p); }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const TrackingAllocator<U>&) const noexcept { return false; }
+};
+
+// --- Report ---
+
+struct ScopeAllocStats {
+    std::string scope; // "outer/inner"
+    std::uint64_t allocs = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes_allocated = 0;
+    std::uint64_t bytes_freed = 0;
+    std::int64_t live = 0;
+    std::int64_t peak = 0; // Largest per-thread peak, not the scope's combined peak
+};
+
+// Sums every thread's counters; scopes without allocations are left out
+inline std::vector<ScopeAllocStats> alloc_snapshot()
+{
+    auto& table = detail::scope_table();
+    const std::uint32_t n = table.count.load(std::memory_order_acquire);
+    std::vector<ScopeAllocStats> out(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        std::string path = table.nodes[i].name;
+        for (std::uint32_t p = table.nodes[i].parent; i != 0 && p != 0; p = table.nodes[p].parent) {
+            path = std::string(table.nodes[p].name) + "/" + path;
+        }
+        out[i].scope = std::move(path);
+    }
+
+    for (auto* t = detail::thread_list().load(std::memory_order_acquire); t != nullptr; t = t->next) {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const detail::ScopeCounters* c = t->find(i);
+            if (c == nullptr) {
+                i = (i / detail::alloc_block_scopes + 1) * detail::alloc_block_scopes - 1;
+                continue;
+            }
+            ScopeAllocStats& s = out[i];
+            s.allocs += c->allocs.load(std::memory_order_relaxed);
+            s.frees += c->frees.load(std::memory_order_relaxed);
+            s.bytes_allocated += c->bytes_allocated.load(std::memory_order_relaxed);
+            s.bytes_freed += c->bytes_freed.load(std::memory_order_relaxed);
+            s.live += c->live.load(std::memory_order_relaxed);
+            s.peak = std::max(s.peak, c->peak.load(std::memory_order_relaxed));
+        }
+    }
+
+    out.erase(std::remove_if(out.begin(), out.end(),
+                  [](const ScopeAllocStats& s) { return s.allocs == 0 && s.frees == 0; }),
+        out.end());
+    std::sort(out.begin(), out.end(), [](const ScopeAllocStats& a, const ScopeAllocStats& b) {
+        return a.bytes_allocated > b.bytes_allocated;
+    });
+    return out;
+}
+
+// Table of allocations per scope, sorted by bytes allocated
+inline void print_alloc_report(std::ostream& os = std::clog)
+{
+    const auto scopes = alloc_snapshot();
+    auto mb = [](double bytes) {
+        std::string out;
+        kitpp::log::detail::append_value(out, bytes / (1024.0 * 1024.0), ".3");
+        return out + " MB";
+    };
+
+    os << "--- kitpp allocations (" << scopes.size() << " scopes) ---\n";
+    os << std::left << std::setw(32) << "Scope" << std::right
+       << std::setw(12) << "Allocs" << std::setw(12) << "Frees"
+       << std::setw(14) << "Allocated" << std::setw(14) << "Live"
+       << std::setw(14) << "Peak/thread" << std::setw(12) << "Avg size" << '\n';
+    for (const auto& s : scopes) {
+        os << std::left << std::setw(32) << s.scope << std::right
+           << std::setw(12) << s.allocs << std::setw(12) << s.frees
+           << std::setw(14) << mb(static_cast<double>(s.bytes_allocated))
+           << std::setw(14) << mb(static_cast<double>(s.live))
+           << std::setw(14) << mb(static_cast<double>(s.peak))
+           << std::setw(12) << (s.allocs > 0 ? s.bytes_allocated / s.allocs : 0) << '\n';
+    }
+    os.flush();
+}
+
+// The alloc_tracker.csv sink (next to speed_tracker.csv / memory_tracker.csv)
+inline log::CsvSink& alloc_tracker()
+{
+    static log::CsvSink sink("alloc_tracker.csv",
+        "Timestamp,Scope,Allocations,Frees,Bytes_Allocated,Bytes_Freed,Live_Bytes,Max_Thread_Peak_Bytes");
+    return sink;
+}
+
+// Appends one row per scope to alloc_tracker.csv
+inline void log_alloc_report()
+{
+    const auto scopes = alloc_snapshot();
+    const std::string_view ts = kitpp::detail::time::timestamp_view();
+    for (const auto& s : scopes) {
+        alloc_tracker().append_row([&](std::string& out) {
+            using log::detail::append_value;
+            out += ts;
+            out += ',';
+            out += s.scope;
+            out += ',';
+            append_value(out, s.allocs, {});
+            out += ',';
+            append_value(out, s.frees, {});
+            out += ',';
+            append_value(out, s.bytes_allocated, {});
+            out += ',';
+            append_value(out, s.bytes_freed, {});
+            out += ',';
+            append_value(out, s.live, {});
+            out += ',';
+            append_value(out, s.peak, {});
+            out += '\n';
+        });
+    }
+}
+
+// Starts recording global new/delete (needs KITPP_TRACK_GLOBAL_ALLOCATIONS()).
+// With report_at_exit the table is printed to std::clog at exit.
+inline void enable_alloc_tracking(bool report_at_exit = true)
+{
+    detail::scope_table();
+    detail::global_tracking().store(true, std::memory_order_relaxed);
+
+    static std::atomic<bool> report { false };
+    report.store(report_at_exit, std::memory_order_relaxed);
+    static const bool registered = (std::atexit([] {
+        if (report.load(std::memory_order_relaxed)) {
+            print_alloc_report();
+        }
+    }), true);
+    (void)registered;
+}
+
+inline void disable_alloc_tracking()
+{
+    detail::global_tracking().store(false, std::memory_order_relaxed);
+}
+
+inline bool tracking_allocations()
+{
+    return detail::global_tracking().load(std::memory_order_relaxed);
+}
+
+} // namespace kitpp::memory
+
+// Charge allocations in the rest of this C++ scope to 'name' (string literal)
+#define KITPP_MEM_SCOPE(name)                                                                     \
+    static kitpp::memory::detail::ScopeSite KITPP_CONCAT(kitpp_mem_site_, __LINE__)(name); \
+    kitpp::memory::MemScope KITPP_CONCAT(kitpp_mem_scope_, __LINE__)(KITPP_CONCAT(kitpp_mem_site_, __LINE__))
+
+// Replaces global operator new/delete with tracked versions. Use once, at
+// namespace scope in one source file of the program.
+#define KITPP_TRACK_GLOBAL_ALLOCATIONS()                                                                   \
+    void* operator new(std::size_t n) { return kitpp::memory::detail::tracked_new(n); }                    \
+    void* operator new[](std::size_t n) { return kitpp::memory::detail::tracked_new(n); }                  \
+    void* operator new(std::size_t n, std::align_val_t a)                                                  \
+    {                                                                                                      \
+        return kitpp::memory::detail::tracked_new(n, static_cast<std::size_t>(a));                         \
+    }                                                                                                      \
+    void* operator new[](std::size_t n, std::align_val_t a)                                                \
+    {                                                                                                      \
+        return kitpp::memory::detail::tracked_new(n, static_cast<std::size_t>(a));                         \
+    }                                                                                                      \
+    void* operator new(std::size_t n, const std::nothrow_t&) noexcept                                      \
+    {                                                                                                      \
+        return kitpp::memory::detail::tracked_malloc(n, 0, false);                                         \
+    }                                                                                                      \
+    void* operator new[](std::size_t n, const std::nothrow_t&) noexcept                                    \
+    {                                                                                                      \
+        return kitpp::memory::detail::tracked_malloc(n, 0, false);                                         \
+    }                                                                                                      \
+    void operator delete(void* p) noexcept { kitpp::memory::detail::tracked_free(p); }                     \
+    void operator delete[](void* p) noexcept { kitpp::memory::detail::tracked_free(p); }                   \
+    void operator delete(void* p, std::size_t) noexcept { kitpp::memory::detail::tracked_free(p); }        \
+    void operator delete[](void* p, std::size_t) noexcept { kitpp::memory::detail::tracked_free(p); }      \
+    void operator delete(void* p, std::align_val_t) noexcept { kitpp::memory::detail::tracked_free(p); }   \
+    void operator delete[](void* p, std::align_val_t) noexcept { kitpp::memory::detail::tracked_free(p); } \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept                                  \
+    {                                                                                                      \
+        kitpp::memory::detail::tracked_free(p);                                                            \
+    }                                                                                                      \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept                                \
+    {                                                                                                      \
+        kitpp::memory::detail::tracked_free(p);                                                            \
+    }                                                                                                      \
+    void operator delete(void* p, const std::nothrow_t&) noexcept { kitpp::memory::detail::tracked_free(p); } \
+    void operator delete[](void* p, const std::nothrow_t&) noexcept { kitpp::memory::detail::tracked_free(p); } \
+    static_assert(true)
+
+#endif // KITPP_ALLOC_TRACKER_HPP
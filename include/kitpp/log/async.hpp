@@ -0,0 +1,324 @@
+#ifndef KITPP_LOG_ASYNC_HPP
+#define KITPP_LOG_ASYNC_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "record.hpp"
+
+namespace kitpp::log {
+
+// What a producer does when the ring buffer is full
+enum class OverflowPolicy {
+    Block,     // Wait until the writer thread frees a slot
+    Drop,      // Discard the record silently
+    CountDrops // Discard the record; the writer reports how many were lost
+};
+
+struct AsyncOptions {
+    std::size_t capacity = 8192; // Rounded up to a power of two
+    OverflowPolicy overflow = OverflowPolicy::Block;
+    std::chrono::milliseconds poll_interval { 2 }; // Writer sleep when idle
+};
+
+namespace detail {
+
+    // Bounded multi-producer / single-consumer ring (Vyukov style).
+    // Producers claim a slot with one CAS on tail_, the writer thread
+    // is the only consumer so head_ is never contended.
+    class RecordQueue {
+    public:
+        explicit RecordQueue(std::size_t capacity)
+        {
+            std::size_t cap = 2;
+            while (cap < capacity) {
+                cap <<= 1;
+            }
+            mask_ = cap - 1;
+            slots_.reset(new Slot[cap]);
+            for (std::size_t i = 0; i < cap; ++i) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_push(Record& rec)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &slots_[pos & mask_];
+                std::size_t seq = slot->seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false; // Full
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+            slot->rec = std::move(rec);
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Single consumer only
+        bool try_pop(Record& out)
+        {
+            Slot& slot = slots_[head_ & mask_];
+            if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+                return false;
+            }
+            out = std::move(slot.rec);
+            slot.seq.store(head_ + mask_ + 1, std::memory_order_release);
+            ++head_;
+            return true;
+        }
+
+        // Number of slots claimed by producers so far
+        std::size_t pushed() const { return tail_.load(std::memory_order_acquire); }
+
+    private:
+        struct Slot {
+            std::atomic<std::size_t> seq { 0 };
+            Record rec;
+        };
+
+        alignas(64) std::atomic<std::size_t> tail_ { 0 };
+        alignas(64) std::size_t head_ = 0;
+        std::size_t mask_ = 0;
+        std::unique_ptr<Slot[]> slots_;
+    };
+
+    // Owns the ring and the writer thread. One per process.
+    class AsyncBackend {
+    public:
+        static AsyncBackend& instance()
+        {
+            static AsyncBackend backend;
+            return backend;
+        }
+
+        ~AsyncBackend() { stop(); }
+
+        bool running() const { return running_.load(std::memory_order_acquire); }
+
+        void start(const AsyncOptions& opts)
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            if (running()) {
+                return;
+            }
+            // The ring is allocated once and kept for the life of the
+            // process, so a producer racing with stop() never touches freed memory.
+            if (!queue_) {
+                queue_ = std::make_unique<RecordQueue>(opts.capacity);
+            }
+            overflow_ = opts.overflow;
+            poll_interval_ = opts.poll_interval;
+            running_.store(true, std::memory_order_release);
+            writer_ = std::thread([this] { run(); });
+
+            static bool registered = false;
+            if (!registered) {
+                registered = true;
+                std::atexit([] { AsyncBackend::instance().stop(); });
+            }
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            if (!running()) {
+                return;
+            }
+            // seq_cst pairs with submit(): a producer either sees the flag
+            // cleared or is counted in producers_ below
+            running_.store(false, std::memory_order_seq_cst);
+            wake();
+            if (writer_.joinable()) {
+                writer_.join();
+            }
+            // Producers that passed the running check finish their push
+            // (or give up and write synchronously) before the final drain
+            while (producers_.load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
+            }
+            // Catch records pushed between the writer's last drain and the flag flip
+            drain();
+        }
+
+        // Returns false if async mode is off or stopping (caller writes synchronously)
+        bool submit(const RecordView& view)
+        {
+            producers_.fetch_add(1, std::memory_order_seq_cst);
+            struct Leave {
+                std::atomic<int>& n;
+                ~Leave() { n.fetch_sub(1, std::memory_order_seq_cst); }
+            } leave { producers_ };
+
+            if (!running_.load(std::memory_order_seq_cst)) {
+                return false;
+            }
+            Record rec(view);
+            while (!queue_->try_push(rec)) {
+                if (overflow_ != OverflowPolicy::Block) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                // The writer is gone once stop() has begun; nothing would free a slot
+                if (!running_.load(std::memory_order_seq_cst)) {
+                    return false;
+                }
+                wake();
+                std::this_thread::yield();
+            }
+            return true;
+        }
+
+        // Blocks until everything submitted before the call has been written
+        void flush()
+        {
+            if (!running()) {
+                std::clog.flush();
+                return;
+            }
+            const std::size_t target = queue_->pushed();
+            std::unique_lock<std::mutex> lock(mutex_);
+            flush_requested_ = true;
+            cv_.notify_all();
+            done_cv_.wait(lock, [&] {
+                return written_.load(std::memory_order_acquire) >= target || !running();
+            });
+        }
+
+        std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        AsyncBackend() = default;
+
+        void wake()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            flush_requested_ = true;
+            cv_.notify_all();
+        }
+
+        // Writes out everything currently in the ring. Writer thread only
+        // (or stop() once the writer has been joined).
+        std::size_t drain()
+        {
+            std::size_t n = 0;
+            while (queue_->try_pop(scratch_)) {
+                write_record(std::clog, scratch_.view());
+                ++n;
+            }
+            bool wrote = n > 0;
+            if (overflow_ == OverflowPolicy::CountDrops) {
+                std::uint64_t total = dropped();
+                if (total != reported_drops_) {
+                    std::string msg = "Async logger dropped "
+                        + std::to_string(total - reported_drops_) + " records (ring full)";
+                    RecordView warn;
+                    warn.level_str = "WARNING ";
+                    warn.level_color = rang::fg::yellow;
+                    warn.file = __FILE__;
+                    warn.line = __LINE__;
+                    warn.func = __func__;
+                    warn.message = msg;
+                    write_record(std::clog, warn);
+                    reported_drops_ = total;
+                    wrote = true;
+                }
+            }
+            if (wrote) {
+                std::clog.flush();
+            }
+            written_.fetch_add(n, std::memory_order_release);
+            return n;
+        }
+
+        void run()
+        {
+            for (;;) {
+                drain();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    done_cv_.notify_all();
+                }
+                if (!running()) {
+                    break;
+                }
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait_for(lock, poll_interval_, [&] { return flush_requested_ || !running(); });
+                flush_requested_ = false;
+            }
+        }
+
+        std::atomic<bool> running_ { false };
+        std::atomic<int> producers_ { 0 }; // Threads inside submit()
+        std::unique_ptr<RecordQueue> queue_;
+        OverflowPolicy overflow_ = OverflowPolicy::Block;
+        std::chrono::milliseconds poll_interval_ { 2 };
+
+        std::thread writer_;
+        std::mutex control_mutex_; // Serializes start/stop
+        std::mutex mutex_;         // Guards the wake/flush handshake
+        std::condition_variable cv_;
+        std::condition_variable done_cv_;
+        bool flush_requested_ = false;
+
+        std::atomic<std::size_t> written_ { 0 };
+        std::atomic<std::uint64_t> dropped_ { 0 };
+        std::uint64_t reported_drops_ = 0;
+        Record scratch_;
+    };
+
+} // namespace detail
+
+// --- Public Control API ---
+
+// Switches every KITPP_LOG_* macro to the background writer.
+// Call once at startup; records are flushed automatically at exit.
+inline void start_async(const AsyncOptions& opts = {})
+{
+    detail::AsyncBackend::instance().start(opts);
+}
+
+// Drains the ring, joins the writer and returns to synchronous logging
+inline void stop_async()
+{
+    detail::AsyncBackend::instance().stop();
+}
+
+inline bool is_async()
+{
+    return detail::AsyncBackend::instance().running();
+}
+
+// Waits until every record logged so far has reached std::clog
+inline void flush()
+{
+    detail::AsyncBackend::instance().flush();
+}
+
+// Records lost to a full ring under Drop / CountDrops
+inline std::uint64_t dropped_records()
+{
+    return detail::AsyncBackend::instance().dropped();
+}
+
+} // namespace kitpp::log
+
+#endif // KITPP_LOG_ASYNC_HPP
@@ -0,0 +1,406 @@
+#ifndef KITPP_LOG_BINARY_HPP
+#define KITPP_LOG_BINARY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "format.hpp"
+#include "level.hpp"
+
+// --- Binary Deferred-Format Logging ---
+// When enabled with kitpp::log::start_binary(path), the KITPP_LOG_*F macros
+// no longer format anything at runtime. Each call site is described once in
+// the file (level, format string, file, line, function); every call then only
+// copies a timestamp and its raw arguments into a per-thread buffer.
+// Decode the file with the kitpp-logdecode tool.
+//
+// File layout (native endianness, same machine assumed):
+//   "KITPPLOG" u32 version
+//   then a sequence of entries, each starting with a u8 tag:
+//   Site:   u32 id, u8 level, u32 line, str fmt, str file, str func
+//   Record: u32 site id, u64 unix time ns, u16 payload bytes, payload
+//   (str = u32 length + bytes; payload = sequence of u8 ArgType + value)
+//   float and long double keep their own width, so decoded lines print
+//   exactly as the text logger would
+
+namespace kitpp::log {
+
+namespace binary {
+
+    inline constexpr char file_magic[8] = { 'K', 'I', 'T', 'P', 'P', 'L', 'O', 'G' };
+    inline constexpr std::uint32_t file_version = 2; // 2: Float32, LongDouble
+
+    enum class EntryTag : std::uint8_t {
+        Site = 1,
+        Record = 2
+    };
+
+    enum class ArgType : std::uint8_t {
+        Int = 1,  // i64
+        UInt = 2, // u64
+        Float = 3, // f64
+        Bool = 4, // u8
+        Char = 5, // u8
+        Str = 6,  // u32 length + bytes
+        Float32 = 7,   // f32, so it prints as the float did
+        LongDouble = 8 // sizeof(long double) bytes, native layout
+    };
+
+} // namespace binary
+
+namespace detail {
+
+    // Static description of one KITPP_LOG_*F call site. Constant-initialized,
+    // the id is assigned the first time the site logs in binary mode.
+    struct CallSite {
+        constexpr CallSite(Level lvl_, const char* file_, int line_, const char* func_)
+            : level(lvl_)
+            , file(file_)
+            , line(line_)
+            , func(func_)
+        {
+        }
+
+        Level level;
+        const char* file;
+        int line;
+        const char* func;
+        std::atomic<std::uint32_t> id { 0 };
+    };
+
+    // Per-thread staging buffer, written to the file when full or on flush
+    struct BinaryThreadBuffer {
+        std::vector<char> data;
+        std::size_t used = 0;
+        ~BinaryThreadBuffer();
+    };
+
+    class BinaryLogger {
+    public:
+        static BinaryLogger& instance()
+        {
+            static BinaryLogger logger;
+            return logger;
+        }
+
+        ~BinaryLogger() { stop(); }
+
+        bool active() const { return active_.load(std::memory_order_relaxed); }
+
+        bool start(const std::string& path, std::size_t thread_buffer_bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (active()) {
+                return true;
+            }
+            file_ = std::fopen(path.c_str(), "wb");
+            if (file_ == nullptr) {
+                return false;
+            }
+            buffer_bytes_.store(thread_buffer_bytes < 1024 ? 1024 : thread_buffer_bytes, std::memory_order_relaxed);
+            std::fwrite(binary::file_magic, 1, sizeof(binary::file_magic), file_);
+            write_raw(binary::file_version);
+            // Sites registered during an earlier session are described again
+            for (const SiteInfo& info : sites_) {
+                write_site(info);
+            }
+            active_.store(true, std::memory_order_release);
+
+            static bool registered = false;
+            if (!registered) {
+                registered = true;
+                std::atexit([] { BinaryLogger::instance().stop(); });
+            }
+            return true;
+        }
+
+        // Writes out every thread's pending records. Other threads must not
+        // be logging concurrently (this runs from stop() and at exit).
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!active()) {
+                return;
+            }
+            active_.store(false, std::memory_order_release);
+            for (BinaryThreadBuffer* buf : buffers_) {
+                write_buffer(*buf);
+            }
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+
+        std::uint32_t register_site(CallSite& site, std::string_view fmt)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::uint32_t id = site.id.load(std::memory_order_relaxed);
+            if (id != 0) {
+                return id; // Another thread won the race
+            }
+            sites_.push_back({ &site, std::string(fmt) });
+            id = static_cast<std::uint32_t>(sites_.size());
+            site.id.store(id, std::memory_order_release);
+            if (file_ != nullptr) {
+                write_site(sites_.back());
+            }
+            return id;
+        }
+
+        // Sized by the latest start(); a thread that logged in an earlier
+        // session writes out its pending records and resizes on next use
+        BinaryThreadBuffer& thread_buffer()
+        {
+            thread_local BinaryThreadBuffer* buf = nullptr;
+            const std::size_t bytes = buffer_bytes_.load(std::memory_order_relaxed);
+            if (buf == nullptr) {
+                thread_local BinaryThreadBuffer storage;
+                storage.data.resize(bytes);
+                buf = &storage;
+                std::lock_guard<std::mutex> lock(mutex_);
+                buffers_.push_back(buf);
+            } else if (buf->data.size() != bytes) {
+                std::lock_guard<std::mutex> lock(mutex_); // stop() may be writing it out
+                write_buffer(*buf);
+                buf->data.resize(bytes);
+                buf->data.shrink_to_fit();
+            }
+            return *buf;
+        }
+
+        // Called by the owning thread only
+        void flush_buffer(BinaryThreadBuffer& buf)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            write_buffer(buf);
+        }
+
+        void release_buffer(BinaryThreadBuffer& buf)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            write_buffer(buf);
+            for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+                if (*it == &buf) {
+                    buffers_.erase(it);
+                    break;
+                }
+            }
+        }
+
+    private:
+        BinaryLogger() = default;
+
+        template <typename T>
+        void write_raw(const T& v)
+        {
+            std::fwrite(&v, sizeof(T), 1, file_);
+        }
+
+        void write_str(std::string_view s)
+        {
+            write_raw(static_cast<std::uint32_t>(s.size()));
+            std::fwrite(s.data(), 1, s.size(), file_);
+        }
+
+        // The format string is copied: only the first one seen at a site is kept
+        struct SiteInfo {
+            const CallSite* site;
+            std::string fmt;
+        };
+
+        void write_site(const SiteInfo& info)
+        {
+            write_raw(binary::EntryTag::Site);
+            write_raw(info.site->id.load(std::memory_order_relaxed));
+            write_raw(static_cast<std::uint8_t>(info.site->level));
+            write_raw(static_cast<std::uint32_t>(info.site->line));
+            write_str(info.fmt);
+            write_str(info.site->file);
+            write_str(info.site->func);
+        }
+
+        void write_buffer(BinaryThreadBuffer& buf)
+        {
+            if (file_ != nullptr && buf.used > 0) {
+                std::fwrite(buf.data.data(), 1, buf.used, file_);
+            }
+            buf.used = 0;
+        }
+
+        std::atomic<bool> active_ { false };
+        std::mutex mutex_;
+        std::FILE* file_ = nullptr;
+        std::atomic<std::size_t> buffer_bytes_ { 64 * 1024 };
+        std::vector<SiteInfo> sites_;
+        std::vector<BinaryThreadBuffer*> buffers_;
+    };
+
+    inline BinaryThreadBuffer::~BinaryThreadBuffer()
+    {
+        BinaryLogger::instance().release_buffer(*this);
+    }
+
+    // --- Argument Encoding ---
+
+    // Types without a raw encoding are formatted to text up front
+    template <typename T>
+    inline decltype(auto) encodable(const T& v)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_arithmetic_v<U> || std::is_convertible_v<const U&, std::string_view>) {
+            return (v);
+        } else {
+            std::string s;
+            append_value(s, v, {});
+            return s;
+        }
+    }
+
+    template <typename T>
+    inline std::size_t encoded_size(const T& v)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool> || std::is_same_v<U, char>) {
+            return 2;
+        } else if constexpr (std::is_same_v<U, float>) {
+            return 1 + sizeof(float);
+        } else if constexpr (std::is_same_v<U, long double>) {
+            return 1 + sizeof(long double);
+        } else if constexpr (std::is_arithmetic_v<U>) {
+            return 9;
+        } else {
+            return 5 + std::string_view(v).size();
+        }
+    }
+
+    template <typename T>
+    inline char* put(char* p, const T& v)
+    {
+        std::memcpy(p, &v, sizeof(T));
+        return p + sizeof(T);
+    }
+
+    template <typename T>
+    inline char* encode_arg(char* p, const T& v)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            p = put(p, binary::ArgType::Bool);
+            return put(p, static_cast<std::uint8_t>(v));
+        } else if constexpr (std::is_same_v<U, char>) {
+            p = put(p, binary::ArgType::Char);
+            return put(p, v);
+        } else if constexpr (std::is_same_v<U, float>) {
+            p = put(p, binary::ArgType::Float32);
+            return put(p, v);
+        } else if constexpr (std::is_same_v<U, long double>) {
+            p = put(p, binary::ArgType::LongDouble);
+            return put(p, v);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            p = put(p, binary::ArgType::Float);
+            return put(p, static_cast<double>(v));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            p = put(p, binary::ArgType::Int);
+            return put(p, static_cast<std::int64_t>(v));
+        } else if constexpr (std::is_integral_v<U>) {
+            p = put(p, binary::ArgType::UInt);
+            return put(p, static_cast<std::uint64_t>(v));
+        } else {
+            std::string_view s(v);
+            p = put(p, binary::ArgType::Str);
+            p = put(p, static_cast<std::uint32_t>(s.size()));
+            std::memcpy(p, s.data(), s.size());
+            return p + s.size();
+        }
+    }
+
+    constexpr std::size_t binary_record_header = 1 + 4 + 8 + 2;
+
+    // Returns false if the record cannot be encoded: its payload exceeds
+    // 64 KiB or the record does not fit the thread buffer. The caller then
+    // logs it as a text line instead.
+    template <typename... Args>
+    inline bool write_binary_encoded(CallSite& site, std::string_view fmt, const Args&... args)
+    {
+        BinaryLogger& logger = BinaryLogger::instance();
+        std::uint32_t id = site.id.load(std::memory_order_acquire);
+        if (id == 0) {
+            id = logger.register_site(site, fmt);
+        }
+
+        const std::size_t payload = (std::size_t { 0 } + ... + encoded_size(args));
+        const std::size_t total = binary_record_header + payload;
+        BinaryThreadBuffer& buf = logger.thread_buffer();
+        if (payload > 0xFFFF || total > buf.data.size()) {
+            return false;
+        }
+        if (buf.used + total > buf.data.size()) {
+            logger.flush_buffer(buf);
+        }
+
+        const auto ts = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+                                                       .count());
+        char* p = buf.data.data() + buf.used;
+        p = put(p, binary::EntryTag::Record);
+        p = put(p, id);
+        p = put(p, ts);
+        p = put(p, static_cast<std::uint16_t>(payload));
+        ((p = encode_arg(p, args)), ...);
+        buf.used += total;
+        return true;
+    }
+
+    template <typename... Args>
+    inline bool write_binary(CallSite& site, std::string_view fmt, const Args&... args)
+    {
+        return write_binary_encoded(site, fmt, encodable(args)...);
+    }
+
+} // namespace detail
+
+// --- Public Control API ---
+
+// Switches the KITPP_LOG_*F macros to binary records written to 'path'.
+// Returns false if the file cannot be opened. Each thread stages records
+// in a buffer of 'thread_buffer_bytes' (at least 1 KiB); a record larger
+// than that, or with more than 64 KiB of arguments, is logged as a text
+// line instead of a binary record.
+inline bool start_binary(const std::string& path, std::size_t thread_buffer_bytes = 64 * 1024)
+{
+    return detail::BinaryLogger::instance().start(path, thread_buffer_bytes);
+}
+
+// Writes all pending records and closes the file. Call when no other
+// thread is logging; runs automatically at exit.
+inline void stop_binary()
+{
+    detail::BinaryLogger::instance().stop();
+}
+
+inline bool is_binary()
+{
+    return detail::BinaryLogger::instance().active();
+}
+
+// Writes the calling thread's pending binary records to the file
+inline void flush_binary()
+{
+    auto& logger = detail::BinaryLogger::instance();
+    if (logger.active()) {
+        logger.flush_buffer(logger.thread_buffer());
+    }
+}
+
+} // namespace kitpp::log
+
+#endif // KITPP_LOG_BINARY_HPP
@@ -0,0 +1,208 @@
+#ifndef KITPP_CSV_SINK_HPP
+#define KITPP_CSV_SINK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace kitpp::log {
+
+// --- CsvSink ---
+// Long-lived CSV writer shared by the timers and memory trackers.
+// The file is opened once (append mode, header written if it is empty).
+// An existing file whose header differs (written by a version with
+// other columns) is first renamed to <path>.old, replacing an older one,
+// so one file never mixes rows of two layouts.
+// Rows are collected in per-thread buffers and written when a buffer
+// passes the size threshold, on the first row after the flush interval
+// has elapsed, on flush(), on set_path() and when the sink is destroyed
+// at exit.
+class CsvSink {
+public:
+    CsvSink(std::string path, std::string header)
+        : path_(std::move(path))
+        , header_(std::move(header))
+        , id_(next_id().fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    ~CsvSink() { flush(); }
+
+    CsvSink(const CsvSink&) = delete;
+    CsvSink& operator=(const CsvSink&) = delete;
+
+    // Pending rows go to the old file; later rows to the new one
+    void set_path(std::string path)
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        if (out_.is_open()) {
+            out_.close();
+        }
+        path_ = std::move(path);
+    }
+
+    std::string path() const
+    {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        return path_;
+    }
+
+    void set_flush_threshold(std::size_t bytes) { threshold_.store(bytes, std::memory_order_relaxed); }
+
+    void set_flush_interval(std::chrono::milliseconds interval)
+    {
+        interval_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+            std::memory_order_relaxed);
+    }
+
+    // Appends one row: fill(std::string&) writes the fields and the trailing '\n'
+    template <typename Fill>
+    void append_row(Fill&& fill)
+    {
+        Shard& shard = thread_shard();
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        fill(shard.data);
+
+        if (shard.data.size() < threshold_.load(std::memory_order_relaxed)) {
+            lock.unlock();
+            // Interval elapsed: whichever thread notices first writes everyone's rows
+            const auto now = now_ns();
+            auto last = last_flush_ns_.load(std::memory_order_relaxed);
+            if (now - last >= interval_ns_.load(std::memory_order_relaxed)
+                && last_flush_ns_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+                flush();
+            }
+            return;
+        }
+        std::string rows;
+        rows.swap(shard.data);
+        shard.data.reserve(rows.capacity());
+        lock.unlock();
+
+        std::lock_guard<std::mutex> file_lock(file_mutex_);
+        write_locked(rows);
+        out_.flush();
+    }
+
+    void write_row(std::string_view row)
+    {
+        append_row([row](std::string& out) {
+            out += row;
+            out += '\n';
+        });
+    }
+
+    // Writes every thread's buffered rows
+    void flush()
+    {
+        std::vector<std::shared_ptr<Shard>> shards;
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            shards = shards_;
+        }
+        std::lock_guard<std::mutex> file_lock(file_mutex_);
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            write_locked(shard->data);
+            shard->data.clear();
+        }
+        if (out_.is_open()) {
+            out_.flush();
+        }
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex; // Only contended while another thread flushes
+        std::string data;
+    };
+
+    static std::atomic<std::uint64_t>& next_id()
+    {
+        static std::atomic<std::uint64_t> id { 1 };
+        return id;
+    }
+
+    static std::int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // The calling thread's buffer for this sink. Shards are shared with the
+    // sink, so rows from threads that have exited are still flushed.
+    Shard& thread_shard()
+    {
+        thread_local std::vector<std::pair<std::uint64_t, std::shared_ptr<Shard>>> cache;
+        for (auto& entry : cache) {
+            if (entry.first == id_) {
+                return *entry.second;
+            }
+        }
+        auto shard = std::make_shared<Shard>();
+        shard->data.reserve(threshold_.load(std::memory_order_relaxed) + 256);
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            shards_.push_back(shard);
+        }
+        cache.emplace_back(id_, shard);
+        return *shard;
+    }
+
+    void write_locked(const std::string& rows)
+    {
+        if (rows.empty()) {
+            return;
+        }
+        if (!out_.is_open()) {
+            rotate_if_header_differs();
+            out_.open(path_, std::ios::app);
+            if (out_.tellp() == 0) {
+                out_ << header_ << '\n';
+            }
+        }
+        out_.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+    }
+
+    void rotate_if_header_differs() const
+    {
+        std::ifstream in(path_);
+        std::string first;
+        if (!std::getline(in, first) || first == header_) {
+            return; // Missing, empty or same columns: append
+        }
+        in.close();
+        const std::string old = path_ + ".old";
+        std::remove(old.c_str());
+        std::rename(path_.c_str(), old.c_str());
+    }
+
+    std::string path_;
+    const std::string header_;
+    const std::uint64_t id_;
+
+    std::atomic<std::size_t> threshold_ { 64 * 1024 };
+    std::atomic<std::int64_t> interval_ns_ { 1000000000 }; // 1 s
+    std::atomic<std::int64_t> last_flush_ns_ { now_ns() };
+
+    std::mutex shards_mutex_;
+    std::vector<std::shared_ptr<Shard>> shards_;
+
+    mutable std::mutex file_mutex_; // Guards path_ and out_
+    std::ofstream out_;
+};
+
+} // namespace kitpp::log
+
+#endif // KITPP_CSV_SINK_HPP
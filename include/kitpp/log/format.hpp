@@ -0,0 +1,182 @@
+#ifndef KITPP_LOG_FORMAT_HPP
+#define KITPP_LOG_FORMAT_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace kitpp::log::detail {
+
+// --- Fixed-Width Helpers ---
+
+// Writes 'value' zero-padded to at least 'width' digits, returns the new end
+inline char* write_padded(char* p, unsigned long long value, int width)
+{
+    char tmp[24];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    for (auto len = res.ptr - tmp; len < width; ++len) {
+        *p++ = '0';
+    }
+    for (const char* q = tmp; q != res.ptr; ++q) {
+        *p++ = *q;
+    }
+    return p;
+}
+
+// Per-thread scratch strings. They are cleared, never shrunk, so once a
+// thread has logged a few lines formatting no longer allocates.
+inline std::string& format_buffer()
+{
+    thread_local std::string buf = [] {
+        std::string s;
+        s.reserve(512);
+        return s;
+    }();
+    return buf;
+}
+
+// Second buffer for values embedded in a formatted line (KITPP_LOG_VAR)
+inline std::string& value_buffer()
+{
+    thread_local std::string buf = [] {
+        std::string s;
+        s.reserve(128);
+        return s;
+    }();
+    return buf;
+}
+
+// Formats as "12.3 us", picking ns/us/ms/s by magnitude
+struct HumanDuration {
+    double ns;
+};
+
+// --- Minimal "{}" Formatter (C++17, no <format>) ---
+// Supports "{}" for any streamable type, "{:.N}" for fixed-point floats,
+// and "{{" / "}}" escapes. Used by the KITPP_LOG_*F macros.
+
+template <typename T>
+inline void append_value(std::string& out, const T& value, std::string_view spec)
+{
+    using U = std::decay_t<T>;
+    char buf[64];
+
+    if constexpr (std::is_same_v<U, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_same_v<U, HumanDuration>) {
+        static const char* units[] = { "ns", "us", "ms", "s" };
+        double v = value.ns;
+        int u = 0;
+        while (u < 3 && (v >= 1000.0 || v <= -1000.0)) {
+            v /= 1000.0;
+            ++u;
+        }
+        int n = std::snprintf(buf, sizeof(buf), "%.3g %s", v, units[u]);
+        out.append(buf, static_cast<std::size_t>(n > 0 ? n : 0));
+    } else if constexpr (std::is_same_v<U, char>) {
+        out += value;
+    } else if constexpr (std::is_integral_v<U>) {
+        auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, res.ptr);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        std::to_chars_result res;
+        if (spec.size() > 1 && spec[0] == '.') {
+            int precision = 0;
+            std::from_chars(spec.data() + 1, spec.data() + spec.size(), precision);
+            res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, precision);
+        } else {
+            res = std::to_chars(buf, buf + sizeof(buf), value);
+        }
+        if (res.ec == std::errc()) {
+            out.append(buf, res.ptr);
+        } else {
+            out += "<float>";
+        }
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        out += std::string_view(value);
+    } else if constexpr (std::is_pointer_v<U>) {
+        out += "0x";
+        auto res = std::to_chars(buf, buf + sizeof(buf), reinterpret_cast<std::uintptr_t>(value), 16);
+        out.append(buf, res.ptr);
+    } else {
+        // Anything else goes through its operator<<
+        std::ostringstream ss;
+        ss << value;
+        out += ss.str();
+    }
+}
+
+// Type-erased argument so the parser below is not instantiated per call site
+struct FormatArg {
+    const void* ptr;
+    void (*append)(std::string&, const void*, std::string_view);
+};
+
+template <typename T>
+inline void append_erased(std::string& out, const void* p, std::string_view spec)
+{
+    append_value(out, *static_cast<const T*>(p), spec);
+}
+
+inline void vformat_to(std::string& out, std::string_view fmt,
+    const FormatArg* args, std::size_t nargs)
+{
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < fmt.size(); ++i) {
+        char c = fmt[i];
+        if (c == '{' && i + 1 < fmt.size() && fmt[i + 1] == '{') {
+            out += '{';
+            ++i;
+        } else if (c == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') {
+            out += '}';
+            ++i;
+        } else if (c == '{') {
+            std::size_t close = fmt.find('}', i);
+            if (close == std::string_view::npos) {
+                out.append(fmt.substr(i));
+                return;
+            }
+            std::string_view spec = fmt.substr(i + 1, close - i - 1);
+            if (!spec.empty() && spec[0] == ':') {
+                spec.remove_prefix(1);
+            }
+            if (next < nargs) {
+                args[next].append(out, args[next].ptr, spec);
+                ++next;
+            } else {
+                out.append(fmt.substr(i, close - i + 1)); // Missing argument: keep placeholder
+            }
+            i = close;
+        } else {
+            out += c;
+        }
+    }
+}
+
+template <typename... Args>
+inline void format_to(std::string& out, std::string_view fmt, const Args&... args)
+{
+    if constexpr (sizeof...(Args) == 0) {
+        vformat_to(out, fmt, nullptr, 0);
+    } else {
+        const FormatArg erased[] = { { &args, &append_erased<Args> }... };
+        vformat_to(out, fmt, erased, sizeof...(Args));
+    }
+}
+
+template <typename... Args>
+inline std::string format(std::string_view fmt, const Args&... args)
+{
+    std::string out;
+    format_to(out, fmt, args...);
+    return out;
+}
+
+} // namespace kitpp::log::detail
+
+#endif // KITPP_LOG_FORMAT_HPP
@@ -0,0 +1,353 @@
+#ifndef KITPP_HISTOGRAM_HPP
+#define KITPP_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <ostream>
+
+namespace kitpp::stats {
+
+// --- HDR-Style Histogram ---
+// Log-linear buckets as in HdrHistogram: values from 'lowest' to 'highest'
+// are kept with 'significant_digits' decimal digits of precision (value
+// error below 10^-digits). Recording is one relaxed atomic increment of a
+// bucket (wait-free) plus a compare-exchange on the rare new min / max, so
+// one instance may be shared by threads or kept per thread and merged.
+// Values outside the range are clamped and counted as saturated.
+class Histogram {
+public:
+    explicit Histogram(std::int64_t lowest = 1, std::int64_t highest = 3600LL * 1000000000LL,
+        int significant_digits = 2)
+    {
+        lowest_ = std::max<std::int64_t>(lowest, 1);
+        highest_ = std::max<std::int64_t>(highest, 2 * lowest_);
+        digits_ = std::clamp(significant_digits, 1, 5);
+
+        const double largest_single_unit = 2.0 * std::pow(10.0, digits_);
+        sub_bucket_count_magnitude_ = static_cast<int>(std::ceil(std::log2(largest_single_unit)));
+        sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude_ - 1;
+        sub_bucket_count_ = 1 << sub_bucket_count_magnitude_;
+        sub_bucket_half_count_ = sub_bucket_count_ / 2;
+        unit_magnitude_ = 63 - __builtin_clzll(static_cast<std::uint64_t>(lowest_));
+        sub_bucket_mask_ = static_cast<std::uint64_t>(sub_bucket_count_ - 1) << unit_magnitude_;
+
+        // Buckets needed so the top one covers 'highest'
+        std::int64_t smallest_untrackable = static_cast<std::int64_t>(sub_bucket_count_) << unit_magnitude_;
+        bucket_count_ = 1;
+        while (smallest_untrackable <= highest_) {
+            if (smallest_untrackable > std::numeric_limits<std::int64_t>::max() / 2) {
+                ++bucket_count_;
+                break;
+            }
+            smallest_untrackable <<= 1;
+            ++bucket_count_;
+        }
+        counts_len_ = (bucket_count_ + 1) * sub_bucket_half_count_;
+        counts_.reset(new std::atomic<std::uint64_t>[counts_len_]);
+        reset();
+    }
+
+    Histogram(const Histogram& other)
+        : Histogram(other.lowest_, other.highest_, other.digits_)
+    {
+        merge(other);
+    }
+
+    Histogram& operator=(const Histogram& other)
+    {
+        if (this != &other) {
+            Histogram copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    void swap(Histogram& other) noexcept
+    {
+        std::swap(lowest_, other.lowest_);
+        std::swap(highest_, other.highest_);
+        std::swap(digits_, other.digits_);
+        std::swap(unit_magnitude_, other.unit_magnitude_);
+        std::swap(sub_bucket_count_magnitude_, other.sub_bucket_count_magnitude_);
+        std::swap(sub_bucket_half_count_magnitude_, other.sub_bucket_half_count_magnitude_);
+        std::swap(sub_bucket_count_, other.sub_bucket_count_);
+        std::swap(sub_bucket_half_count_, other.sub_bucket_half_count_);
+        std::swap(sub_bucket_mask_, other.sub_bucket_mask_);
+        std::swap(bucket_count_, other.bucket_count_);
+        std::swap(counts_len_, other.counts_len_);
+        counts_.swap(other.counts_);
+        exchange_atomic(total_, other.total_);
+        exchange_atomic(saturated_, other.saturated_);
+        exchange_atomic(min_, other.min_);
+        exchange_atomic(max_, other.max_);
+    }
+
+    // --- Recording ---
+
+    void record(std::int64_t value, std::uint64_t count = 1) noexcept
+    {
+        if (value < 0) {
+            value = 0;
+        }
+        if (value > highest_) {
+            value = highest_;
+            saturated_.fetch_add(count, std::memory_order_relaxed);
+        }
+        counts_[index_of(value)].fetch_add(count, std::memory_order_relaxed);
+        total_.fetch_add(count, std::memory_order_relaxed);
+        update_min(value);
+        update_max(value);
+    }
+
+    // Adds every count of 'other' (which may use a different layout)
+    void merge(const Histogram& other)
+    {
+        other.for_each_bucket([this](std::int64_t low, std::int64_t, std::uint64_t n) {
+            if (n != 0) {
+                std::int64_t v = std::clamp(low, std::int64_t(0), highest_);
+                counts_[index_of(v)].fetch_add(n, std::memory_order_relaxed);
+                total_.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+        if (other.count() > 0) {
+            update_min(other.min());
+            update_max(std::min(other.max(), highest_));
+        }
+        saturated_.fetch_add(other.saturated(), std::memory_order_relaxed);
+    }
+
+    void reset() noexcept
+    {
+        for (std::size_t i = 0; i < counts_len_; ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        total_.store(0, std::memory_order_relaxed);
+        saturated_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    // --- Queries ---
+
+    std::uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+    std::uint64_t saturated() const { return saturated_.load(std::memory_order_relaxed); }
+    std::int64_t min() const { return count() == 0 ? 0 : min_.load(std::memory_order_relaxed); }
+    std::int64_t max() const { return max_.load(std::memory_order_relaxed); }
+    int significant_digits() const { return digits_; }
+    std::int64_t lowest() const { return lowest_; }
+    std::int64_t highest() const { return highest_; }
+    int bucket_count() const { return bucket_count_; }
+    int sub_bucket_count() const { return sub_bucket_count_; }
+
+    double mean() const
+    {
+        double sum = 0.0;
+        std::uint64_t n = 0;
+        for_each_bucket([&](std::int64_t low, std::int64_t high, std::uint64_t c) {
+            sum += midpoint(low, high) * static_cast<double>(c);
+            n += c;
+        });
+        return n == 0 ? 0.0 : sum / static_cast<double>(n);
+    }
+
+    double stddev() const
+    {
+        const double m = mean();
+        double sq = 0.0;
+        std::uint64_t n = 0;
+        for_each_bucket([&](std::int64_t low, std::int64_t high, std::uint64_t c) {
+            const double d = midpoint(low, high) - m;
+            sq += d * d * static_cast<double>(c);
+            n += c;
+        });
+        return n == 0 ? 0.0 : std::sqrt(sq / static_cast<double>(n));
+    }
+
+    // Highest value equivalent to the one at 'percentile' (0..100),
+    // clamped to the recorded max
+    std::int64_t value_at_percentile(double percentile) const
+    {
+        const std::uint64_t n = count();
+        if (n == 0) {
+            return 0;
+        }
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        auto target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(n)));
+        target = std::max<std::uint64_t>(target, 1);
+        std::uint64_t seen = 0;
+        std::int64_t result = max();
+        bool found = false;
+        for_each_bucket([&](std::int64_t, std::int64_t high, std::uint64_t c) {
+            if (found) {
+                return;
+            }
+            seen += c;
+            if (seen >= target) {
+                result = high;
+                found = true;
+            }
+        });
+        return std::clamp(result, min(), max());
+    }
+
+    // Calls fn(lowest, highest, count) for every bucket in value order
+    template <typename Fn>
+    void for_each_bucket(Fn&& fn) const
+    {
+        for (int b = 0; b < bucket_count_; ++b) {
+            for (int s = (b == 0 ? 0 : sub_bucket_half_count_); s < sub_bucket_count_; ++s) {
+                const std::uint64_t c = counts_[counts_index(b, s)].load(std::memory_order_relaxed);
+                const std::int64_t low = static_cast<std::int64_t>(s) << (b + unit_magnitude_);
+                const std::int64_t size = std::int64_t(1) << (b + unit_magnitude_);
+                fn(low, low + size - 1, c);
+            }
+        }
+    }
+
+    // --- Export ---
+
+    // "Value_Low,Value_High,Count,Cumulative_Percentile" for non-empty buckets,
+    // values divided by 'scale' (e.g. 1000 for ns -> us)
+    void write_csv(std::ostream& os, double scale = 1.0) const
+    {
+        const std::uint64_t n = count();
+        std::uint64_t seen = 0;
+        os << "Value_Low,Value_High,Count,Cumulative_Percentile\n";
+        char line[128];
+        for_each_bucket([&](std::int64_t low, std::int64_t high, std::uint64_t c) {
+            if (c == 0) {
+                return;
+            }
+            seen += c;
+            std::snprintf(line, sizeof(line), "%.3f,%.3f,%llu,%.6f\n",
+                static_cast<double>(low) / scale, static_cast<double>(high) / scale,
+                static_cast<unsigned long long>(c), 100.0 * static_cast<double>(seen) / static_cast<double>(n));
+            os << line;
+        });
+    }
+
+    // HdrHistogram's percentile distribution text (as written by
+    // outputPercentileDistribution), readable by the HDR plotting tools
+    void write_percentiles(std::ostream& os, double scale = 1.0, int ticks_per_half_distance = 5) const
+    {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+        os << line;
+
+        const std::uint64_t n = count();
+        if (n > 0) {
+            double next_percentile = 0.0;
+            std::uint64_t seen = 0;
+            bool done = false;
+            for_each_bucket([&](std::int64_t, std::int64_t high, std::uint64_t c) {
+                if (done || c == 0) {
+                    return;
+                }
+                seen += c;
+                const double reached = 100.0 * static_cast<double>(seen) / static_cast<double>(n);
+                const double value = static_cast<double>(std::min(high, max())) / scale;
+                while (!done && reached >= next_percentile) {
+                    if (seen == n) {
+                        std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu\n", value, 1.0,
+                            static_cast<unsigned long long>(seen));
+                        os << line;
+                        done = true;
+                        break;
+                    }
+                    std::snprintf(line, sizeof(line), "%12.3f %2.12f %10llu %14.2f\n", value,
+                        next_percentile / 100.0, static_cast<unsigned long long>(seen),
+                        1.0 / (1.0 - next_percentile / 100.0));
+                    os << line;
+                    // Finer steps towards the tail: ticks per halving of the distance to 100%
+                    const double half_distance = std::pow(2.0,
+                        std::floor(std::log2(100.0 / (100.0 - next_percentile))) + 1.0);
+                    next_percentile += 100.0 / (ticks_per_half_distance * half_distance);
+                }
+            });
+        }
+
+        std::snprintf(line, sizeof(line), "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / scale, stddev() / scale);
+        os << line;
+        std::snprintf(line, sizeof(line), "#[Max     = %12.3f, Total count    = %12llu]\n",
+            static_cast<double>(max()) / scale, static_cast<unsigned long long>(n));
+        os << line;
+        std::snprintf(line, sizeof(line), "#[Buckets = %12d, SubBuckets     = %12d]\n", bucket_count_, sub_bucket_count_);
+        os << line;
+    }
+
+private:
+    static void exchange_atomic(std::atomic<std::uint64_t>& a, std::atomic<std::uint64_t>& b)
+    {
+        std::uint64_t t = a.load(std::memory_order_relaxed);
+        a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        b.store(t, std::memory_order_relaxed);
+    }
+
+    static void exchange_atomic(std::atomic<std::int64_t>& a, std::atomic<std::int64_t>& b)
+    {
+        std::int64_t t = a.load(std::memory_order_relaxed);
+        a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        b.store(t, std::memory_order_relaxed);
+    }
+
+    static double midpoint(std::int64_t low, std::int64_t high)
+    {
+        return (static_cast<double>(low) + static_cast<double>(high)) / 2.0;
+    }
+
+    std::size_t counts_index(int bucket, int sub_bucket) const
+    {
+        const int base = (bucket + 1) << sub_bucket_half_count_magnitude_;
+        return static_cast<std::size_t>(base + sub_bucket - sub_bucket_half_count_);
+    }
+
+    std::size_t index_of(std::int64_t value) const
+    {
+        const auto v = static_cast<std::uint64_t>(value);
+        const int pow2_ceiling = 64 - __builtin_clzll(v | sub_bucket_mask_);
+        const int bucket = pow2_ceiling - unit_magnitude_ - (sub_bucket_half_count_magnitude_ + 1);
+        const int sub_bucket = static_cast<int>(v >> (bucket + unit_magnitude_));
+        return counts_index(bucket, sub_bucket);
+    }
+
+    void update_min(std::int64_t v)
+    {
+        std::int64_t cur = min_.load(std::memory_order_relaxed);
+        while (v < cur && !min_.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    void update_max(std::int64_t v)
+    {
+        std::int64_t cur = max_.load(std::memory_order_relaxed);
+        while (v > cur && !max_.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::int64_t lowest_;
+    std::int64_t highest_;
+    int digits_;
+    int unit_magnitude_;
+    int sub_bucket_count_magnitude_;
+    int sub_bucket_half_count_magnitude_;
+    int sub_bucket_count_;
+    int sub_bucket_half_count_;
+    std::uint64_t sub_bucket_mask_;
+    int bucket_count_;
+    std::size_t counts_len_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts_;
+
+    std::atomic<std::uint64_t> total_ { 0 };
+    std::atomic<std::uint64_t> saturated_ { 0 };
+    std::atomic<std::int64_t> min_ { std::numeric_limits<std::int64_t>::max() };
+    std::atomic<std::int64_t> max_ { 0 };
+};
+
+} // namespace kitpp::stats
+
+#endif // KITPP_HISTOGRAM_HPP
@@ -0,0 +1,113 @@
+#ifndef KITPP_LOG_LEVEL_HPP
+#define KITPP_LOG_LEVEL_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+
+#include "../external/rang.hpp"
+
+// --- Compile-Time Threshold ---
+// Levels below KITPP_LOG_ACTIVE_LEVEL are compiled out entirely: their
+// arguments are never evaluated. Set with the meson 'log_level' option
+// or -DKITPP_LOG_ACTIVE_LEVEL=<n>.
+
+#define KITPP_LEVEL_TRACE 0
+#define KITPP_LEVEL_DEBUG 1
+#define KITPP_LEVEL_INFO 2
+#define KITPP_LEVEL_WARN 3
+#define KITPP_LEVEL_ERROR 4
+#define KITPP_LEVEL_OFF 5
+
+#ifndef KITPP_LOG_ACTIVE_LEVEL
+#define KITPP_LOG_ACTIVE_LEVEL KITPP_LEVEL_TRACE
+#endif
+
+namespace kitpp::log {
+
+enum class Level : int {
+    Trace = KITPP_LEVEL_TRACE,
+    Debug = KITPP_LEVEL_DEBUG,
+    Info = KITPP_LEVEL_INFO,
+    Warn = KITPP_LEVEL_WARN,
+    Error = KITPP_LEVEL_ERROR,
+    Off = KITPP_LEVEL_OFF
+};
+
+namespace detail {
+
+    // Accepts "trace".."off" or a digit; anything else yields fallback
+    inline Level parse_level(const char* text, Level fallback)
+    {
+        if (text == nullptr || *text == '\0') {
+            return fallback;
+        }
+        std::string_view s(text);
+        if (s.size() == 1 && s[0] >= '0' && s[0] <= '5') {
+            return static_cast<Level>(s[0] - '0');
+        }
+        if (s == "trace") return Level::Trace;
+        if (s == "debug") return Level::Debug;
+        if (s == "info") return Level::Info;
+        if (s == "warn" || s == "warning") return Level::Warn;
+        if (s == "error") return Level::Error;
+        if (s == "off") return Level::Off;
+        return fallback;
+    }
+
+    // Runtime threshold, seeded once from $KITPP_LOG_LEVEL (default: info)
+    inline std::atomic<int>& runtime_level()
+    {
+        static std::atomic<int> level(static_cast<int>(
+            parse_level(std::getenv("KITPP_LOG_LEVEL"), Level::Info)));
+        return level;
+    }
+
+    // Column label, padded to the same width as the original INFO/WARNING/ERROR
+    constexpr std::string_view level_label(Level lvl)
+    {
+        switch (lvl) {
+        case Level::Trace: return "TRACE   ";
+        case Level::Debug: return "DEBUG   ";
+        case Level::Info: return "INFO    ";
+        case Level::Warn: return "WARNING ";
+        case Level::Error: return "ERROR   ";
+        default: return "        ";
+        }
+    }
+
+    constexpr rang::fg level_color(Level lvl)
+    {
+        switch (lvl) {
+        case Level::Trace: return rang::fg::gray;
+        case Level::Debug: return rang::fg::blue;
+        case Level::Info: return rang::fg::cyan;
+        case Level::Warn: return rang::fg::yellow;
+        case Level::Error: return rang::fg::red;
+        default: return rang::fg::reset;
+        }
+    }
+
+} // namespace detail
+
+inline void set_level(Level lvl)
+{
+    detail::runtime_level().store(static_cast<int>(lvl), std::memory_order_relaxed);
+}
+
+inline Level get_level()
+{
+    return static_cast<Level>(detail::runtime_level().load(std::memory_order_relaxed));
+}
+
+// The check every macro runs before touching its arguments:
+// constant-folded against the compile-time threshold, then one relaxed load.
+inline bool should_log(Level lvl)
+{
+    return static_cast<int>(lvl) >= KITPP_LOG_ACTIVE_LEVEL
+        && static_cast<int>(lvl) >= detail::runtime_level().load(std::memory_order_relaxed);
+}
+
+} // namespace kitpp::log
+
+#endif // KITPP_LOG_LEVEL_HPP
@@ -1,6 +1,7 @@
 #ifndef KITPP_LOG_HPP
 #define KITPP_LOG_HPP
 
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -9,81 +10,249 @@
 
 #include "../external/rang.hpp"
 #include "../sys/platform.hpp"
+#include "../sys/thread_info.hpp"
+#include "async.hpp"
+#include "binary.hpp"
+#include "format.hpp"
+#include "level.hpp"
+#include "record.hpp"
+#include "sampling.hpp"
 
 namespace kitpp::log {
 
 namespace detail {
+    // Hands the record to the async writer when enabled, else writes it now
+    inline void dispatch(const RecordView& rec)
+    {
+        if (!AsyncBackend::instance().submit(rec)) {
+            write_record(std::clog, rec);
+        }
+    }
+
     // Internal implementation matching your logger.hpp
     inline void log_impl(const std::string_view level_str,
         const rang::fg level_color, const std::string_view message,
         const char* file, int line, const char* func)
     {
-        std::clog << rang::style::bold << level_color << level_str << "| "
-                  << rang::style::reset << rang::style::bold
-                  << "Source_File: " << rang::style::reset << rang::fg::red << file
-                  << rang::style::reset << '(' << rang::fgB::cyan << "L" << line
-                  << rang::style::reset << ")   `" << rang::fg::yellow << func
-                  << rang::style::reset << "`: " << message << '\n';
+        RecordView rec;
+        rec.level_str = level_str;
+        rec.level_color = level_color;
+        rec.file = file;
+        rec.line = line;
+        rec.func = func;
+        rec.message = message;
+        dispatch(rec);
+    }
+
+    inline void log_impl(Level lvl, const std::string_view message,
+        const char* file, int line, const char* func)
+    {
+        log_impl(level_label(lvl), level_color(lvl), message, file, line, func);
+    }
+
+    // Only reached once the level check has passed
+    template <typename... Args>
+    inline void logf_impl(Level lvl, const char* file, int line, const char* func,
+        std::string_view fmt, const Args&... args)
+    {
+        std::string& buf = format_buffer();
+        buf.clear();
+        format_to(buf, fmt, args...);
+        log_impl(lvl, buf, file, line, func);
+    }
+
+    // Entry point of the *F macros: binary record when enabled, else text
+    template <typename... Args>
+    inline void logf_site(CallSite& site, std::string_view fmt, const Args&... args)
+    {
+        if (BinaryLogger::instance().active() && write_binary(site, fmt, args...)) {
+            return;
+        }
+        logf_impl(site.level, site.file, site.line, site.func, fmt, args...);
+    }
+
+    // Line emitted by a sampled macro, noting how many calls it stands for
+    inline void log_sampled_impl(Level lvl, const std::string_view message,
+        std::uint64_t suppressed, const char* file, int line, const char* func)
+    {
+        if (suppressed == 0) {
+            log_impl(lvl, message, file, line, func);
+        } else {
+            logf_impl(lvl, file, line, func, "{} [{} suppressed]", message, suppressed);
+        }
     }
 
-    inline void log_var_impl(const std::string_view var_name, const std::string& type_name,
-        const std::string& value_str,
+    template <typename... Args>
+    constexpr void discard(const Args&...)
+    {
+    }
+
+    inline void log_var_impl(const std::string_view var_name, const std::string_view type_name,
+        const std::string_view value_str,
         const char* file, int line, const char* func)
     {
-        std::clog << rang::style::bold << rang::fg::magenta << "VAR     | "
-                  << rang::style::reset << rang::style::bold
-                  << "Source_File: " << rang::style::reset << rang::fg::red << file
-                  << rang::style::reset << '(' << rang::fgB::cyan << "L" << line
-                  << rang::style::reset << ")   `" << rang::fg::yellow << func
-                  << rang::style::reset << "`: " << rang::fg::magenta
-                  << "Type: " << rang::style::reset << rang::fg::cyan
-                  << type_name << rang::style::reset << ", "
-                  << rang::fg::magenta << "Name: " << rang::style::reset
-                  << rang::fg::cyan << var_name << rang::style::reset << ", "
-                  << rang::fg::magenta << "Value: " << rang::style::reset
-                  << rang::fg::cyan << value_str << rang::style::reset << '\n';
+        RecordView rec;
+        rec.kind = RecordKind::Var;
+        rec.file = file;
+        rec.line = line;
+        rec.func = func;
+        rec.message = value_str;
+        rec.var_name = var_name;
+        rec.type_name = type_name;
+        dispatch(rec);
     }
 
+    // The thread details are captured here, on the calling thread. tid is
+    // the kernel id (as in perf/top); the CPU is the only value read anew.
     inline void thread_context_impl(std::string_view label,
         const char* file, int line, const char* func)
     {
-        std::clog << rang::style::bold << rang::fg::cyan << "THREAD  | " << rang::style::reset
-                  << "pid=" << kitpp::pid()
-                  << " tid=" << kitpp::tid_string()
-                  << " omp_tid=" << kitpp::omp_tid()
-                  << " team=" << kitpp::omp_team()
-                  << " cpu=" << kitpp::cpu_index()
-                  << " | " << label
-                  << " @ " << file << ":" << line << " `" << func << "`\n";
+        const ThreadInfo& self = kitpp::thread_info();
+        std::string& body = format_buffer();
+        body.clear();
+        format_to(body, "pid={} tid={} thread={} '{}' omp_tid={} team={} cpu={} | {}",
+            kitpp::pid(), self.tid, self.index, self.name_view(), kitpp::omp_tid(), kitpp::omp_team(),
+            kitpp::cpu_index(), label);
+
+        RecordView rec;
+        rec.kind = RecordKind::Thread;
+        rec.file = file;
+        rec.line = line;
+        rec.func = func;
+        rec.message = body;
+        dispatch(rec);
     }
 } // namespace detail
 
 // --- User-Facing Macros (C++17) ---
+// Every macro checks the level first, so message arguments (string
+// concatenation, to_string, ...) are only evaluated for records that print.
+
+#define KITPP_LOG_AT_(lvl, message)                                                   \
+    do {                                                                              \
+        if (kitpp::log::should_log(lvl)) {                                            \
+            kitpp::log::detail::log_impl(lvl, message, __FILE__, __LINE__, __func__); \
+        }                                                                             \
+    } while (0)
 
-#define KITPP_LOG_INFO(message) \
-    kitpp::log::detail::log_impl("INFO    ", rang::fg::cyan, message, __FILE__, __LINE__, __func__)
+// Format-style variant: KITPP_LOG_INFOF("{} items in {:.3} s", n, secs)
+// The format string must be a literal; each call site is registered once
+// for binary logging (see binary.hpp).
+#define KITPP_LOGF_AT_(lvl, ...)                                                                    \
+    do {                                                                                            \
+        if (kitpp::log::should_log(lvl)) {                                                          \
+            static kitpp::log::detail::CallSite kitpp_log_site_(lvl, __FILE__, __LINE__, __func__); \
+            kitpp::log::detail::logf_site(kitpp_log_site_, __VA_ARGS__);                            \
+        }                                                                                           \
+    } while (0)
 
-#define KITPP_LOG_WARN(message) \
-    kitpp::log::detail::log_impl("WARNING ", rang::fg::yellow, message, __FILE__, __LINE__, __func__)
+// Compiled-out level: arguments are type-checked but never evaluated
+#define KITPP_LOG_DISCARD_(...)                       \
+    do {                                              \
+        if (false) {                                  \
+            kitpp::log::detail::discard(__VA_ARGS__); \
+        }                                             \
+    } while (0)
 
-#define KITPP_LOG_ERROR(message) \
-    kitpp::log::detail::log_impl("ERROR   ", rang::fg::red, message, __FILE__, __LINE__, __func__)
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_TRACE
+#define KITPP_LOG_TRACE(message) KITPP_LOG_AT_(kitpp::log::Level::Trace, message)
+#define KITPP_LOG_TRACEF(...) KITPP_LOGF_AT_(kitpp::log::Level::Trace, __VA_ARGS__)
+#else
+#define KITPP_LOG_TRACE(message) KITPP_LOG_DISCARD_(message)
+#define KITPP_LOG_TRACEF(...) KITPP_LOG_DISCARD_(__VA_ARGS__)
+#endif
 
-#define KITPP_LOG_THREAD_CONTEXT(label) \
-    kitpp::log::detail::thread_context_impl(label, __FILE__, __LINE__, __func__)
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_DEBUG
+#define KITPP_LOG_DEBUG(message) KITPP_LOG_AT_(kitpp::log::Level::Debug, message)
+#define KITPP_LOG_DEBUGF(...) KITPP_LOGF_AT_(kitpp::log::Level::Debug, __VA_ARGS__)
+#else
+#define KITPP_LOG_DEBUG(message) KITPP_LOG_DISCARD_(message)
+#define KITPP_LOG_DEBUGF(...) KITPP_LOG_DISCARD_(__VA_ARGS__)
+#endif
+
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_INFO
+#define KITPP_LOG_INFO(message) KITPP_LOG_AT_(kitpp::log::Level::Info, message)
+#define KITPP_LOG_INFOF(...) KITPP_LOGF_AT_(kitpp::log::Level::Info, __VA_ARGS__)
+#else
+#define KITPP_LOG_INFO(message) KITPP_LOG_DISCARD_(message)
+#define KITPP_LOG_INFOF(...) KITPP_LOG_DISCARD_(__VA_ARGS__)
+#endif
+
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_WARN
+#define KITPP_LOG_WARN(message) KITPP_LOG_AT_(kitpp::log::Level::Warn, message)
+#define KITPP_LOG_WARNF(...) KITPP_LOGF_AT_(kitpp::log::Level::Warn, __VA_ARGS__)
+#else
+#define KITPP_LOG_WARN(message) KITPP_LOG_DISCARD_(message)
+#define KITPP_LOG_WARNF(...) KITPP_LOG_DISCARD_(__VA_ARGS__)
+#endif
+
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_ERROR
+#define KITPP_LOG_ERROR(message) KITPP_LOG_AT_(kitpp::log::Level::Error, message)
+#define KITPP_LOG_ERRORF(...) KITPP_LOGF_AT_(kitpp::log::Level::Error, __VA_ARGS__)
+#else
+#define KITPP_LOG_ERROR(message) KITPP_LOG_DISCARD_(message)
+#define KITPP_LOG_ERRORF(...) KITPP_LOG_DISCARD_(__VA_ARGS__)
+#endif
+
+// --- Sampled / Rate-Limited Macros (INFO) ---
+// For hot loops. Each call site keeps its own counter or deadline; a
+// skipped call does one relaxed atomic op and never evaluates the message.
+
+#define KITPP_LOG_SAMPLED_(sampler, param, message)                                    \
+    do {                                                                               \
+        if (kitpp::log::should_log(kitpp::log::Level::Info)) {                         \
+            static kitpp::log::detail::sampler kitpp_log_sampler_;                     \
+            std::uint64_t kitpp_log_suppressed_ = 0;                                   \
+            if (kitpp_log_sampler_.should_emit(param, kitpp_log_suppressed_)) {        \
+                kitpp::log::detail::log_sampled_impl(kitpp::log::Level::Info, message, \
+                    kitpp_log_suppressed_, __FILE__, __LINE__, __func__);              \
+            }                                                                          \
+        }                                                                              \
+    } while (0)
+
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_INFO
+// Logs the 1st, (n+1)th, (2n+1)th ... call
+#define KITPP_LOG_EVERY_N(n, message) KITPP_LOG_SAMPLED_(EveryNSampler, n, message)
+// Logs at most once every 'ms' milliseconds
+#define KITPP_LOG_EVERY_MS(ms, message) KITPP_LOG_SAMPLED_(EveryMsSampler, ms, message)
+// Logs only the first n calls
+#define KITPP_LOG_FIRST_N(n, message) KITPP_LOG_SAMPLED_(FirstNSampler, n, message)
+#else
+#define KITPP_LOG_EVERY_N(n, message) KITPP_LOG_DISCARD_(n, message)
+#define KITPP_LOG_EVERY_MS(ms, message) KITPP_LOG_DISCARD_(ms, message)
+#define KITPP_LOG_FIRST_N(n, message) KITPP_LOG_DISCARD_(n, message)
+#endif
 
 // Helper to genericize value printing
 template <typename T>
 inline void log_var_helper(const std::string_view name, const T& value, const char* file, int line, const char* func)
 {
-    // Use stream to string conversion to support non-string types safely
-    std::ostringstream ss;
-    ss << value;
-    kitpp::log::detail::log_var_impl(name, typeid(T).name(), ss.str(), file, line, func);
+    // Numbers and strings go through to_chars; other types through operator<<
+    std::string& text = kitpp::log::detail::value_buffer();
+    text.clear();
+    kitpp::log::detail::append_value(text, value, {});
+    kitpp::log::detail::log_var_impl(name, typeid(T).name(), text, file, line, func);
 }
 
-#define KITPP_LOG_VAR(variable) \
-    kitpp::log::log_var_helper(#variable, variable, __FILE__, __LINE__, __func__)
+// VAR and THREAD lines are filtered as INFO
+#if KITPP_LOG_ACTIVE_LEVEL <= KITPP_LEVEL_INFO
+#define KITPP_LOG_THREAD_CONTEXT(label)                                                   \
+    do {                                                                                  \
+        if (kitpp::log::should_log(kitpp::log::Level::Info)) {                            \
+            kitpp::log::detail::thread_context_impl(label, __FILE__, __LINE__, __func__); \
+        }                                                                                 \
+    } while (0)
+
+#define KITPP_LOG_VAR(variable)                                                            \
+    do {                                                                                   \
+        if (kitpp::log::should_log(kitpp::log::Level::Info)) {                             \
+            kitpp::log::log_var_helper(#variable, variable, __FILE__, __LINE__, __func__); \
+        }                                                                                  \
+    } while (0)
+#else
+#define KITPP_LOG_THREAD_CONTEXT(label) KITPP_LOG_DISCARD_(label)
+#define KITPP_LOG_VAR(variable) KITPP_LOG_DISCARD_(variable)
+#endif
 
 } // namespace kitpp::log
 
@@ -4,31 +4,32 @@
 #include <string>
 #include <utility>
 
+#include "../sys/clock.hpp"
 #include "../sys/platform.hpp" // For OpenMP checks/includes
 #include "log.hpp"
+#include "timer_overhead.hpp"
+#include "timer_stats.hpp"
+#include "trace_sink.hpp"
 #include "TimerCommon.hpp"
 
 namespace kitpp {
 
-// --- ManualTimer (Console Only, Explicit Control) ---
-class ManualTimer {
+// --- BasicManualTimer (Console Only, Explicit Control) ---
+// Clock is a policy from sys/clock.hpp; ManualTimer uses the default one.
+template <typename Clock = clocks::DefaultClock>
+class BasicManualTimer {
 public:
-    ManualTimer(std::string label, const char* file, int line, const char* func)
+    BasicManualTimer(std::string label, const char* file, int line, const char* func)
         : label_(std::move(label))
         , file_(file)
         , line_(line)
         , func_(func)
         , is_running_(false)
+        , start_time_ {}
     {
-        // Initializing start_time_ to default
-#if defined(_OPENMP)
-        start_time_ = 0.0;
-#else
-        start_time_ = std::chrono::steady_clock::time_point();
-#endif
     }
 
-    virtual ~ManualTimer()
+    virtual ~BasicManualTimer()
     {
         if (is_running_) {
             stop();
@@ -39,19 +40,21 @@ public:
         if (is_running_) return;
 
         is_running_ = true;
-#if defined(_OPENMP)
-        start_time_ = ::omp_get_wtime();
-#else
-        start_time_ = std::chrono::steady_clock::now();
-#endif
+        start_time_ = Clock::now();
     }
 
-    // Stops the timer and logs the result via virtual on_stop
+    // Stops the timer and logs the result via virtual on_stop_ns
     void stop() {
         if (!is_running_) return;
 
-        long long us = get_elapsed_us();
-        on_stop(us); 
+        long long ns = get_elapsed_ns();
+        if (stats::aggregating()) {
+            stats::record(label_, file_, line_, func_, ns);
+        }
+        if (trace::enabled()) {
+            trace::record(label_, file_, line_, ns);
+        }
+        on_stop_ns(ns);
         
         is_running_ = false;
     }
@@ -71,18 +74,41 @@ public:
 protected:
     long long get_elapsed_us() const
     {
-#if defined(_OPENMP)
-        return static_cast<long long>((::omp_get_wtime() - start_time_) * 1e6);
-#else
-        auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::microseconds>(now - start_time_).count();
-#endif
+        return get_elapsed_ns() / 1000;
+    }
+
+    long long get_elapsed_ns() const
+    {
+        return overhead::adjust<Clock>(Clock::to_ns(Clock::now() - start_time_));
     }
 
     // Virtual hook to allow derived classes (File) to add logging behavior
-    virtual void on_stop(long long us) {
-        std::string msg = "ManualTimer '" + label_ + "' elapsed: " + std::to_string(us) + " us";
-        log::detail::log_impl("INFO    ", rang::fg::cyan, msg, file_, line_, func_);
+    // (no console line while aggregating, see timer_stats.hpp). Receives
+    // nanoseconds; the default forwards to the old microsecond on_stop so
+    // subclasses written against it keep working unchanged.
+    virtual void on_stop_ns(long long ns) {
+        stopped_ns_ = ns;
+#if defined(__GNUC__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+        on_stop(ns / 1000);
+#if defined(__GNUC__)
+  #pragma GCC diagnostic pop
+#endif
+    }
+
+    // Former hook, in microseconds. Overrides still run (and may call this
+    // base version, which logs the full-precision value); new code should
+    // override on_stop_ns instead.
+    [[deprecated("override on_stop_ns (nanoseconds) instead")]]
+    virtual void on_stop(long long /*us*/) {
+        if (!stats::aggregating() && log::should_log(log::Level::Info)) {
+            const long long ns = stopped_ns_;
+            log::detail::logf_impl(log::Level::Info, file_, line_, func_,
+                "ManualTimer '{}' elapsed: {} ns ({}){}", label_, ns,
+                log::detail::HumanDuration { static_cast<double>(ns) }, overhead::note<Clock>());
+        }
     }
 
     std::string label_;
@@ -90,28 +116,28 @@ protected:
     int line_;
     const char* func_;
     bool is_running_;
-
-#if defined(_OPENMP)
-    double start_time_;
-#else
-    std::chrono::time_point<std::chrono::steady_clock> start_time_;
-#endif
+    typename Clock::tick start_time_;
+    long long stopped_ns_ = 0; // Last stop, for the microsecond on_stop
 };
 
-// --- ManualTimerFile (Console + CSV, Explicit Control) ---
-class ManualTimerFile : public ManualTimer {
+// --- BasicManualTimerFile (Console + CSV, Explicit Control) ---
+template <typename Clock = clocks::DefaultClock>
+class BasicManualTimerFile : public BasicManualTimer<Clock> {
 public:
-    using ManualTimer::ManualTimer; // Inherit constructor
+    using BasicManualTimer<Clock>::BasicManualTimer; // Inherit constructor
 
 protected:
-    void on_stop(long long us) override {
+    void on_stop_ns(long long ns) override {
         // Log to CSV first
-        detail::time::log_time_to_file(label_, us, file_, line_, func_);
+        detail::time::log_time_to_file(this->label_, ns, this->file_, this->line_, this->func_);
         // Then log to console via base
-        ManualTimer::on_stop(us);
+        BasicManualTimer<Clock>::on_stop_ns(ns);
     }
 };
 
+using ManualTimer = BasicManualTimer<>;
+using ManualTimerFile = BasicManualTimerFile<>;
+
 } // namespace kitpp
 
 // Macros to capture location in C++17
@@ -122,4 +148,4 @@ protected:
 #define KITPP_MEASURE_MANUAL(label) \
     kitpp::ManualTimerFile(label, __FILE__, __LINE__, __func__)
 
-#endif // KITPP_MANUAL_TIMER_HPP
\ No newline at end of file
+#endif // KITPP_MANUAL_TIMER_HPP
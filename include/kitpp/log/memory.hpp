@@ -1,62 +1,445 @@
 #ifndef KITPP_MEMORY_HPP
 #define KITPP_MEMORY_HPP
 
-#include <fstream>
-#include <mutex>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "csv_sink.hpp"
+#include "format.hpp"
+
 namespace kitpp::memory {
 
 // --- 1. Memory Calculation Templates ---
+// get_footprint(obj) walks an object and everything it owns on the heap.
+// Containers are followed recursively, so a std::vector<std::string> or a
+// map of vectors is counted in full. Element loops are skipped for types
+// that own no heap memory, so a vector<double> of any size costs O(1).
+// Node and bucket layouts follow libstdc++; allocator overhead assumes
+// glibc malloc (8-byte header, 16-byte granularity, 32-byte minimum).
+
+struct Footprint {
+    std::size_t used = 0;     // The object and the live elements it owns
+    std::size_t slack = 0;    // Reserved but unused capacity
+    std::size_t overhead = 0; // Node links, bucket arrays, malloc headers/rounding
+
+    std::size_t total() const { return used + slack + overhead; }
+
+    Footprint& operator+=(const Footprint& other)
+    {
+        used += other.used;
+        slack += other.slack;
+        overhead += other.overhead;
+        return *this;
+    }
+};
+
+namespace detail {
+
+    // Bytes malloc adds to a request of n bytes
+    constexpr std::size_t allocation_overhead(std::size_t n)
+    {
+        if (n == 0) {
+            return 0;
+        }
+        const std::size_t chunk = (n + sizeof(std::size_t) + 15) & ~std::size_t(15);
+        return (chunk < 32 ? 32 : chunk) - n;
+    }
+
+    // Node-based containers: one allocation per element holding 'links'
+    // bytes of bookkeeping next to the value
+    constexpr std::size_t node_overhead(std::size_t value_size, std::size_t links)
+    {
+        return links + allocation_overhead(links + value_size);
+    }
+
+} // namespace detail
+
+// Customization point. Specialize for your own types:
+//
+//   template <> struct kitpp::memory::DeepSize<Particle> {
+//       static constexpr bool owns_heap = true;
+//       static void add_heap(const Particle& p, Footprint& f) {
+//           kitpp::memory::add_heap(p.name, f);
+//           kitpp::memory::add_heap(p.samples, f);
+//       }
+//   };
+//
+// add_heap() adds what obj owns beyond sizeof(obj). The default assumes
+// nothing (plain data, or an unknown type counted as sizeof(T)).
+template <typename T, typename Enable = void>
+struct DeepSize {
+    static constexpr bool owns_heap = false;
+    static void add_heap(const T&, Footprint&) { }
+};
 
-// Default Base Case: Returns sizeof(T)
 template <typename T>
-size_t get_deep_size(const T& obj)
+constexpr bool owns_heap_v = DeepSize<std::remove_cv_t<T>>::owns_heap;
+
+template <typename T>
+void add_heap(const T& obj, Footprint& f)
 {
-    return sizeof(T);
+    if constexpr (owns_heap_v<T>) {
+        DeepSize<std::remove_cv_t<T>>::add_heap(obj, f);
+    }
 }
 
-// Specialization: std::vector
 template <typename T>
-size_t get_deep_size(const std::vector<T>& vec)
+Footprint get_footprint(const T& obj)
 {
-    return sizeof(std::vector<T>) + (vec.capacity() * sizeof(T));
+    Footprint f;
+    f.used = sizeof(T);
+    add_heap(obj, f);
+    return f;
 }
 
-// Specialization: std::string
-inline size_t get_deep_size(const std::string& str)
+// Everything obj occupies: used + slack + overhead
+template <typename T>
+size_t get_deep_size(const T& obj)
 {
-    return sizeof(std::string) + str.capacity();
+    return get_footprint(obj).total();
 }
 
-// --- 2. File Logger Implementation ---
+namespace detail {
 
-inline void log_mem_to_file(const char* var_name, const std::string& context,
-    size_t bytes, const char* file, int line)
-{
-    static std::mutex log_mutex;
-    std::lock_guard<std::mutex> lock(log_mutex);
+    template <typename Range>
+    void add_elements(const Range& range, Footprint& f)
+    {
+        using Value = typename Range::value_type;
+        if constexpr (owns_heap_v<Value>) {
+            for (const auto& v : range) {
+                kitpp::memory::add_heap(v, f);
+            }
+        }
+    }
+
+    // Contiguous storage of 'capacity' elements, 'size' of them live
+    inline void add_buffer(std::size_t size, std::size_t capacity, std::size_t elem, Footprint& f)
+    {
+        if (capacity == 0) {
+            return;
+        }
+        f.used += size * elem;
+        f.slack += (capacity - size) * elem;
+        f.overhead += allocation_overhead(capacity * elem);
+    }
+
+    // Node-based container of 'n' nodes holding 'value' bytes each
+    inline void add_nodes(std::size_t n, std::size_t value, std::size_t links, Footprint& f)
+    {
+        f.used += n * value;
+        f.overhead += n * node_overhead(value, links);
+    }
+
+} // namespace detail
+
+// --- Strings ---
+
+template <typename C, typename Tr, typename A>
+struct DeepSize<std::basic_string<C, Tr, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::basic_string<C, Tr, A>& s, Footprint& f)
+    {
+        // Short strings live inside the object (SSO)
+        const auto* data = reinterpret_cast<const unsigned char*>(s.data());
+        const auto* self = reinterpret_cast<const unsigned char*>(&s);
+        if (data >= self && data < self + sizeof(s)) {
+            return;
+        }
+        detail::add_buffer(s.size() + 1, s.capacity() + 1, sizeof(C), f);
+    }
+};
+
+// --- Sequence containers ---
+
+template <typename T, typename A>
+struct DeepSize<std::vector<T, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::vector<T, A>& v, Footprint& f)
+    {
+        detail::add_buffer(v.size(), v.capacity(), sizeof(T), f);
+        detail::add_elements(v, f);
+    }
+};
+
+template <typename A>
+struct DeepSize<std::vector<bool, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::vector<bool, A>& v, Footprint& f)
+    {
+        const std::size_t word_bits = 8 * sizeof(unsigned long);
+        const std::size_t words = (v.capacity() + word_bits - 1) / word_bits;
+        const std::size_t used = (v.size() + 7) / 8;
+        if (words > 0) {
+            f.used += used;
+            f.slack += words * sizeof(unsigned long) - used;
+            f.overhead += detail::allocation_overhead(words * sizeof(unsigned long));
+        }
+    }
+};
+
+template <typename T, typename A>
+struct DeepSize<std::deque<T, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::deque<T, A>& d, Footprint& f)
+    {
+        // libstdc++: 512-byte blocks plus a map of block pointers (at least 8)
+        const std::size_t per_block = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+        const std::size_t blocks = d.size() / per_block + 1;
+        const std::size_t map = std::max<std::size_t>(8, blocks + 2);
+        f.used += d.size() * sizeof(T);
+        f.slack += blocks * per_block * sizeof(T) - d.size() * sizeof(T);
+        f.overhead += blocks * detail::allocation_overhead(per_block * sizeof(T))
+            + map * sizeof(void*) + detail::allocation_overhead(map * sizeof(void*));
+        detail::add_elements(d, f);
+    }
+};
+
+template <typename T, typename A>
+struct DeepSize<std::list<T, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::list<T, A>& l, Footprint& f)
+    {
+        detail::add_nodes(l.size(), sizeof(T), 2 * sizeof(void*), f);
+        detail::add_elements(l, f);
+    }
+};
+
+template <typename T, typename A>
+struct DeepSize<std::forward_list<T, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::forward_list<T, A>& l, Footprint& f)
+    {
+        const auto n = static_cast<std::size_t>(std::distance(l.begin(), l.end()));
+        detail::add_nodes(n, sizeof(T), sizeof(void*), f);
+        detail::add_elements(l, f);
+    }
+};
+
+template <typename T, std::size_t N>
+struct DeepSize<std::array<T, N>> {
+    static constexpr bool owns_heap = owns_heap_v<T>;
+    static void add_heap(const std::array<T, N>& a, Footprint& f)
+    {
+        detail::add_elements(a, f);
+    }
+};
+
+// --- Ordered associative containers (red-black tree nodes) ---
+
+namespace detail {
+
+    // Color + parent/left/right
+    constexpr std::size_t tree_links = 4 * sizeof(void*);
+
+    template <typename Tree>
+    void add_tree(const Tree& t, Footprint& f)
+    {
+        add_nodes(t.size(), sizeof(typename Tree::value_type), tree_links, f);
+        add_elements(t, f);
+    }
+
+} // namespace detail
+
+template <typename K, typename V, typename C, typename A>
+struct DeepSize<std::map<K, V, C, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::map<K, V, C, A>& m, Footprint& f) { detail::add_tree(m, f); }
+};
+
+template <typename K, typename V, typename C, typename A>
+struct DeepSize<std::multimap<K, V, C, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::multimap<K, V, C, A>& m, Footprint& f) { detail::add_tree(m, f); }
+};
+
+template <typename K, typename C, typename A>
+struct DeepSize<std::set<K, C, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::set<K, C, A>& s, Footprint& f) { detail::add_tree(s, f); }
+};
+
+template <typename K, typename C, typename A>
+struct DeepSize<std::multiset<K, C, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::multiset<K, C, A>& s, Footprint& f) { detail::add_tree(s, f); }
+};
+
+// --- Unordered containers (singly linked nodes + bucket array) ---
+
+namespace detail {
+
+    // libstdc++ caches the hash in each node unless hashing is trivially cheap
+    template <typename Key>
+    constexpr std::size_t hash_links()
+    {
+        constexpr bool fast = std::is_arithmetic_v<Key> || std::is_enum_v<Key> || std::is_pointer_v<Key>;
+        return sizeof(void*) + (fast ? 0 : sizeof(std::size_t));
+    }
+
+    template <typename Table>
+    void add_hash_table(const Table& t, Footprint& f)
+    {
+        add_nodes(t.size(), sizeof(typename Table::value_type), hash_links<typename Table::key_type>(), f);
+        if (t.bucket_count() > 1) { // A single bucket is stored inside the container
+            f.overhead += t.bucket_count() * sizeof(void*) + allocation_overhead(t.bucket_count() * sizeof(void*));
+        }
+        add_elements(t, f);
+    }
+
+} // namespace detail
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct DeepSize<std::unordered_map<K, V, H, E, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::unordered_map<K, V, H, E, A>& m, Footprint& f) { detail::add_hash_table(m, f); }
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct DeepSize<std::unordered_multimap<K, V, H, E, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::unordered_multimap<K, V, H, E, A>& m, Footprint& f) { detail::add_hash_table(m, f); }
+};
+
+template <typename K, typename H, typename E, typename A>
+struct DeepSize<std::unordered_set<K, H, E, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::unordered_set<K, H, E, A>& s, Footprint& f) { detail::add_hash_table(s, f); }
+};
+
+template <typename K, typename H, typename E, typename A>
+struct DeepSize<std::unordered_multiset<K, H, E, A>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::unordered_multiset<K, H, E, A>& s, Footprint& f) { detail::add_hash_table(s, f); }
+};
 
-    // Open file in Append mode
-    std::ofstream outfile("memory_tracker.csv", std::ios::app);
+// --- Wrappers and owning pointers ---
 
-    // Write CSV Header if file is empty/new
-    if (outfile.tellp() == 0) {
-        outfile << "File,Line,Context,Variable,Bytes,Megabytes\n";
+template <typename A, typename B>
+struct DeepSize<std::pair<A, B>> {
+    static constexpr bool owns_heap = owns_heap_v<A> || owns_heap_v<B>;
+    static void add_heap(const std::pair<A, B>& p, Footprint& f)
+    {
+        kitpp::memory::add_heap(p.first, f);
+        kitpp::memory::add_heap(p.second, f);
     }
+};
 
+template <typename... Ts>
+struct DeepSize<std::tuple<Ts...>> {
+    static constexpr bool owns_heap = (owns_heap_v<Ts> || ...);
+    static void add_heap(const std::tuple<Ts...>& t, Footprint& f)
+    {
+        std::apply([&f](const auto&... v) { (kitpp::memory::add_heap(v, f), ...); }, t);
+    }
+};
+
+template <typename T>
+struct DeepSize<std::optional<T>> {
+    static constexpr bool owns_heap = owns_heap_v<T>;
+    static void add_heap(const std::optional<T>& o, Footprint& f)
+    {
+        if (o) {
+            kitpp::memory::add_heap(*o, f);
+        }
+    }
+};
+
+template <typename... Ts>
+struct DeepSize<std::variant<Ts...>> {
+    static constexpr bool owns_heap = (owns_heap_v<Ts> || ...);
+    static void add_heap(const std::variant<Ts...>& v, Footprint& f)
+    {
+        if (!v.valueless_by_exception()) {
+            std::visit([&f](const auto& alt) { kitpp::memory::add_heap(alt, f); }, v);
+        }
+    }
+};
+
+// The pointee (of the static type) and what it owns
+template <typename T, typename D>
+struct DeepSize<std::unique_ptr<T, D>, std::enable_if_t<!std::is_array_v<T>>> {
+    static constexpr bool owns_heap = true;
+    static void add_heap(const std::unique_ptr<T, D>& p, Footprint& f)
+    {
+        if (p) {
+            f.used += sizeof(T);
+            f.overhead += detail::allocation_overhead(sizeof(T));
+            kitpp::memory::add_heap(*p, f);
+        }
+    }
+};
+
+// --- 2. File Logger Implementation ---
+
+// The memory_tracker.csv sink, e.g. memory_tracker().set_path("run42/mem.csv").
+// A file with the older six-column header (no Used/Slack/Overhead) is
+// moved to memory_tracker.csv.old rather than appended to (CsvSink).
+inline log::CsvSink& memory_tracker()
+{
+    static log::CsvSink sink("memory_tracker.csv",
+        "File,Line,Context,Variable,Bytes,Megabytes,Used_Bytes,Slack_Bytes,Overhead_Bytes");
+    return sink;
+}
+
+inline void log_mem_to_file(const char* var_name, const std::string& context,
+    const Footprint& footprint, const char* file, int line)
+{
+    const size_t bytes = footprint.total();
     double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
 
-    outfile << file << "," << line << "," << context << "," << var_name << ","
-            << bytes << "," << mb << "\n";
+    memory_tracker().append_row([&](std::string& out) {
+        using log::detail::append_value;
+        out += file;
+        out += ',';
+        append_value(out, line, {});
+        out += ',';
+        out += context;
+        out += ',';
+        out += var_name;
+        out += ',';
+        append_value(out, bytes, {});
+        out += ',';
+        append_value(out, mb, ".6");
+        out += ',';
+        append_value(out, footprint.used, {});
+        out += ',';
+        append_value(out, footprint.slack, {});
+        out += ',';
+        append_value(out, footprint.overhead, {});
+        out += '\n';
+    });
+}
+
+inline void log_mem_to_file(const char* var_name, const std::string& context,
+    size_t bytes, const char* file, int line)
+{
+    Footprint f;
+    f.used = bytes;
+    log_mem_to_file(var_name, context, f, file, line);
 }
 
 } // namespace kitpp::memory
 
 #define KITPP_LOG_MEM(variable, context)               \
     kitpp::memory::log_mem_to_file(#variable, context, \
-        kitpp::memory::get_deep_size(variable),        \
+        kitpp::memory::get_footprint(variable),        \
         __FILE__, __LINE__)
 
 #endif // KITPP_MEMORY_HPP
@@ -0,0 +1,875 @@
+#ifndef KITPP_METRICS_HPP
+#define KITPP_METRICS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../sys/platform.hpp"
+#include "../sys/resource.hpp"
+#include "histogram.hpp"
+#include "log.hpp"
+#include "throughput_logger.hpp"
+#include "timer_stats.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <arpa/inet.h>
+  #include <netinet/in.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+  #define KITPP_HAS_METRICS_HTTP 1
+#else
+  #define KITPP_HAS_METRICS_HTTP 0
+#endif
+
+namespace kitpp::metrics {
+
+// --- Metrics Registry ---
+// Named counters, gauges and histograms with labels, for scraping by
+// Prometheus-compatible collectors. A metric is registered once (by name
+// and label set) and updated through a handle that is a plain pointer to
+// its cell: inc() / set() / observe() are relaxed atomic operations, no
+// lookup and no lock. Callback metrics and collectors read existing kitpp
+// data (ThroughputLogger totals, timer statistics, peak RSS) when the
+// registry is rendered. Output is the OpenMetrics text format, or the
+// Prometheus 0.0.4 text format that node_exporter's textfile collector
+// reads; write_textfile() replaces the file atomically (temp + rename).
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+enum class Format {
+    OpenMetrics, // application/openmetrics-text 1.0.0, ends with "# EOF"
+    Prometheus   // text/plain 0.0.4 (node_exporter textfile collector)
+};
+
+namespace detail {
+
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct HistogramCell {
+        explicit HistogramCell(std::shared_ptr<const std::vector<double>> b)
+            : bounds(std::move(b))
+            , counts(new std::atomic<std::uint64_t>[bounds->size() + 1])
+        {
+            for (std::size_t i = 0; i <= bounds->size(); ++i) {
+                counts[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::shared_ptr<const std::vector<double>> bounds; // Sorted upper bounds, +Inf implied
+        std::unique_ptr<std::atomic<std::uint64_t>[]> counts; // Per bucket, not cumulative
+        std::atomic<double> sum { 0.0 };
+    };
+
+    struct Series {
+        Labels labels;
+        alignas(64) std::atomic<std::uint64_t> counter { 0 };
+        std::atomic<double> gauge { 0.0 };
+        std::unique_ptr<HistogramCell> hist;
+        std::function<double()> read; // Callback series
+        std::uint64_t owner = 0;      // Registration id of a callback or collector series
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        Type type = Type::Counter;
+        std::shared_ptr<const std::vector<double>> bounds;
+        std::map<Labels, std::unique_ptr<Series>> series;
+    };
+
+    inline void add_double(std::atomic<double>& a, double v)
+    {
+        double cur = a.load(std::memory_order_relaxed);
+        while (!a.compare_exchange_weak(cur, cur + v, std::memory_order_relaxed)) {
+        }
+    }
+
+    inline bool valid_name(std::string_view name)
+    {
+        if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+            return false;
+        }
+        return std::all_of(name.begin(), name.end(), [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+        });
+    }
+
+    // Counter families are named without the "_total" sample suffix
+    inline std::string_view family_name(std::string_view name, Type type)
+    {
+        constexpr std::string_view suffix = "_total";
+        if (type == Type::Counter && name.size() > suffix.size()
+            && name.substr(name.size() - suffix.size()) == suffix) {
+            name.remove_suffix(suffix.size());
+        }
+        return name;
+    }
+
+    // Shortest round-trip text; "+Inf" / "-Inf" / "NaN" as the formats spell them
+    inline void append_number(std::string& out, double v)
+    {
+        if (std::isnan(v)) {
+            out += "NaN";
+        } else if (std::isinf(v)) {
+            out += v > 0 ? "+Inf" : "-Inf";
+        } else {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), v);
+            out.append(buf, res.ptr);
+        }
+    }
+
+    inline void append_escaped(std::string& out, std::string_view text, bool quote)
+    {
+        for (char c : text) {
+            if (c == '\\') {
+                out += "\\\\";
+            } else if (c == '\n') {
+                out += "\\n";
+            } else if (c == '"' && quote) {
+                out += "\\\"";
+            } else {
+                out += c;
+            }
+        }
+    }
+
+    // name{a="1",b="2"} -- 'extra' is the histogram "le" label
+    inline void append_sample_name(std::string& out, std::string_view name, std::string_view suffix,
+        const Labels& labels, std::string_view extra_value = {})
+    {
+        out += name;
+        out += suffix;
+        if (labels.empty() && extra_value.empty()) {
+            return;
+        }
+        out += '{';
+        bool first = true;
+        for (const auto& label : labels) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            out += label.first;
+            out += "=\"";
+            append_escaped(out, label.second, true);
+            out += '"';
+        }
+        if (!extra_value.empty()) {
+            if (!first) {
+                out += ',';
+            }
+            out += "le=\"";
+            out += extra_value;
+            out += '"';
+        }
+        out += '}';
+    }
+
+    // Id of the collector running on this thread (0 outside collectors)
+    inline std::uint64_t& collecting_owner()
+    {
+        thread_local std::uint64_t id = 0;
+        return id;
+    }
+
+    class Registry {
+    public:
+        static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        // Existing series of a family, or a new one. nullptr if the name is
+        // invalid or already registered with another type. Series created
+        // by a collector belong to it and are removed with it.
+        Series* series(std::string_view name, std::string_view help, Type type, const Labels& labels,
+            const std::vector<double>* bounds = nullptr)
+        {
+            if (!valid_name(name)) {
+                KITPP_LOG_ERRORF("metrics: invalid metric name '{}'", name);
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            Family* family = find_or_add(family_name(name, type), help, type, bounds);
+            if (family == nullptr) {
+                return nullptr;
+            }
+            auto it = family->series.find(labels);
+            if (it != family->series.end() && it->second->read) {
+                KITPP_LOG_ERRORF("metrics: '{}' has a callback series with the same labels", name);
+                return nullptr;
+            }
+            if (it == family->series.end()) {
+                auto s = std::make_unique<Series>();
+                s->labels = labels;
+                if (type == Type::Histogram) {
+                    s->hist = std::make_unique<HistogramCell>(family->bounds);
+                }
+                s->owner = collecting_owner();
+                it = family->series.emplace(labels, std::move(s)).first;
+            }
+            return it->second.get();
+        }
+
+        std::uint64_t add_callback(std::string_view name, std::string_view help, Type type,
+            const Labels& labels, std::function<double()> read)
+        {
+            const std::uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!valid_name(name)) {
+                KITPP_LOG_ERRORF("metrics: invalid metric name '{}'", name);
+                return 0;
+            }
+            Family* family = find_or_add(family_name(name, type), help, type, nullptr);
+            if (family == nullptr) {
+                return 0;
+            }
+            auto& slot = family->series[labels];
+            if (slot && !slot->read) {
+                KITPP_LOG_ERRORF("metrics: '{}' already has a series with the same labels", name);
+                return 0;
+            }
+            slot = std::make_unique<Series>();
+            slot->labels = labels;
+            slot->read = std::move(read);
+            slot->owner = id;
+            return id;
+        }
+
+        std::uint64_t add_collector(std::function<void()> collect)
+        {
+            const std::uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(collect_mutex_);
+            collectors_.emplace_back(id, std::move(collect));
+            return id;
+        }
+
+        // Waits for a render in progress, so the callback's data may go away after
+        void remove(std::uint64_t id)
+        {
+            std::lock_guard<std::mutex> collect_lock(collect_mutex_);
+            collectors_.erase(std::remove_if(collectors_.begin(), collectors_.end(),
+                                  [id](const auto& c) { return c.first == id; }),
+                collectors_.end());
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& family : families_) {
+                for (auto it = family->series.begin(); it != family->series.end();) {
+                    it = it->second->owner == id ? family->series.erase(it) : std::next(it);
+                }
+            }
+        }
+
+        void render(std::string& out, Format format)
+        {
+            std::lock_guard<std::mutex> collect_lock(collect_mutex_);
+            for (auto& collector : collectors_) {
+                collecting_owner() = collector.first;
+                collector.second();
+                collecting_owner() = 0;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& family : families_) {
+                if (!family->series.empty()) {
+                    render_family(out, *family, format);
+                }
+            }
+            if (format == Format::OpenMetrics) {
+                out += "# EOF\n";
+            }
+        }
+
+    private:
+        Registry() = default;
+
+        Family* find_or_add(std::string_view name, std::string_view help, Type type,
+            const std::vector<double>* bounds)
+        {
+            for (auto& family : families_) {
+                if (family->name == name) {
+                    if (family->type != type) {
+                        KITPP_LOG_ERRORF("metrics: '{}' is already registered with another type", name);
+                        return nullptr;
+                    }
+                    return family.get();
+                }
+            }
+            auto family = std::make_unique<Family>();
+            family->name.assign(name.data(), name.size());
+            family->help.assign(help.data(), help.size());
+            family->type = type;
+            if (type == Type::Histogram) {
+                std::vector<double> b = bounds != nullptr ? *bounds : std::vector<double> {};
+                std::sort(b.begin(), b.end());
+                b.erase(std::unique(b.begin(), b.end()), b.end());
+                b.erase(std::remove_if(b.begin(), b.end(), [](double v) { return std::isinf(v) || std::isnan(v); }),
+                    b.end());
+                family->bounds = std::make_shared<const std::vector<double>>(std::move(b));
+            }
+            families_.push_back(std::move(family));
+            return families_.back().get();
+        }
+
+        static void render_family(std::string& out, const Family& family, Format format)
+        {
+            // The Prometheus format names counter families with their "_total" suffix
+            std::string_view name = family.name;
+            const bool counter = family.type == Type::Counter;
+            const char* type = counter ? "counter" : family.type == Type::Gauge ? "gauge" : "histogram";
+
+            out += "# TYPE ";
+            out += name;
+            if (counter && format == Format::Prometheus) {
+                out += "_total";
+            }
+            out += ' ';
+            out += type;
+            out += '\n';
+            if (!family.help.empty()) {
+                out += "# HELP ";
+                out += name;
+                if (counter && format == Format::Prometheus) {
+                    out += "_total";
+                }
+                out += ' ';
+                append_escaped(out, family.help, false);
+                out += '\n';
+            }
+
+            for (const auto& entry : family.series) {
+                const Series& s = *entry.second;
+                if (family.type == Type::Histogram && s.hist) {
+                    render_histogram(out, name, s);
+                    continue;
+                }
+                append_sample_name(out, name, counter ? "_total" : "", s.labels);
+                out += ' ';
+                if (s.read) {
+                    append_number(out, s.read());
+                } else if (counter) {
+                    out += std::to_string(s.counter.load(std::memory_order_relaxed));
+                } else {
+                    append_number(out, s.gauge.load(std::memory_order_relaxed));
+                }
+                out += '\n';
+            }
+        }
+
+        static void render_histogram(std::string& out, std::string_view name, const Series& s)
+        {
+            const HistogramCell& h = *s.hist;
+            const auto& bounds = *h.bounds;
+            std::uint64_t cumulative = 0;
+            std::string le;
+            for (std::size_t i = 0; i <= bounds.size(); ++i) {
+                cumulative += h.counts[i].load(std::memory_order_relaxed);
+                le.clear();
+                append_number(le, i < bounds.size() ? bounds[i] : HUGE_VAL);
+                append_sample_name(out, name, "_bucket", s.labels, le);
+                out += ' ';
+                out += std::to_string(cumulative);
+                out += '\n';
+            }
+            append_sample_name(out, name, "_count", s.labels);
+            out += ' ';
+            out += std::to_string(cumulative);
+            out += '\n';
+            append_sample_name(out, name, "_sum", s.labels);
+            out += ' ';
+            append_number(out, h.sum.load(std::memory_order_relaxed));
+            out += '\n';
+        }
+
+        std::mutex mutex_; // Guards families_
+        std::vector<std::unique_ptr<Family>> families_;
+        std::mutex collect_mutex_; // Held for a whole render; guards collectors_
+        std::vector<std::pair<std::uint64_t, std::function<void()>>> collectors_;
+        std::atomic<std::uint64_t> next_id_ { 1 };
+    };
+
+} // namespace detail
+
+// --- Handles ---
+// Copyable, valid for the life of the program. A handle whose registration
+// failed (bad name, type clash) updates a cell that is never exported.
+
+class Counter {
+public:
+    Counter() = default;
+    explicit Counter(detail::Series* s)
+        : cell_(s != nullptr ? &s->counter : &detached())
+    {
+    }
+
+    void inc(std::uint64_t n = 1) const noexcept { cell_->fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const noexcept { return cell_->load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<std::uint64_t>& detached()
+    {
+        static std::atomic<std::uint64_t> cell { 0 };
+        return cell;
+    }
+
+    std::atomic<std::uint64_t>* cell_ = &detached();
+};
+
+class Gauge {
+public:
+    Gauge() = default;
+    explicit Gauge(detail::Series* s)
+        : cell_(s != nullptr ? &s->gauge : &detached())
+    {
+    }
+
+    void set(double v) const noexcept { cell_->store(v, std::memory_order_relaxed); }
+    void add(double v) const noexcept { detail::add_double(*cell_, v); }
+    void inc() const noexcept { add(1.0); }
+    void dec() const noexcept { add(-1.0); }
+    double value() const noexcept { return cell_->load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<double>& detached()
+    {
+        static std::atomic<double> cell { 0.0 };
+        return cell;
+    }
+
+    std::atomic<double>* cell_ = &detached();
+};
+
+class Histogram {
+public:
+    Histogram() = default;
+    explicit Histogram(detail::Series* s)
+        : cell_(s != nullptr ? s->hist.get() : &detached())
+    {
+    }
+
+    // Counts v in the first bucket whose upper bound is >= v
+    void observe(double v) const noexcept
+    {
+        const auto& bounds = *cell_->bounds;
+        const std::size_t i = std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin();
+        cell_->counts[i].fetch_add(1, std::memory_order_relaxed);
+        detail::add_double(cell_->sum, v);
+    }
+
+    // Replaces the contents with a stats::Histogram, values divided by
+    // 'scale' (1e9: ns -> s). For collectors; not atomic with observe().
+    void assign(const stats::Histogram& h, double scale = 1.0) const
+    {
+        const auto& bounds = *cell_->bounds;
+        std::vector<std::uint64_t> counts(bounds.size() + 1, 0);
+        h.for_each_bucket([&](std::int64_t, std::int64_t high, std::uint64_t c) {
+            if (c == 0) {
+                return;
+            }
+            const double v = static_cast<double>(high) / scale;
+            counts[std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin()] += c;
+        });
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            cell_->counts[i].store(counts[i], std::memory_order_relaxed);
+        }
+        cell_->sum.store(h.mean() * static_cast<double>(h.count()) / scale, std::memory_order_relaxed);
+    }
+
+private:
+    static detail::HistogramCell& detached()
+    {
+        static detail::HistogramCell cell(std::make_shared<const std::vector<double>>());
+        return cell;
+    }
+
+    detail::HistogramCell* cell_ = &detached();
+};
+
+// Unregisters a callback metric or collector when destroyed
+class Registration {
+public:
+    Registration() = default;
+    explicit Registration(std::uint64_t id)
+        : id_(id)
+    {
+    }
+    ~Registration() { reset(); }
+
+    Registration(Registration&& other) noexcept
+        : id_(std::exchange(other.id_, 0))
+    {
+    }
+    Registration& operator=(Registration&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            id_ = std::exchange(other.id_, 0);
+        }
+        return *this;
+    }
+
+    void reset()
+    {
+        if (id_ != 0) {
+            detail::Registry::instance().remove(std::exchange(id_, 0));
+        }
+    }
+
+    // Keeps the registration for the rest of the program
+    void release() { id_ = 0; }
+
+private:
+    std::uint64_t id_ = 0;
+};
+
+// --- Registration ---
+
+// 'name' may end in "_total"; the suffix is added to the sample either way
+inline Counter counter(std::string_view name, std::string_view help = {}, const Labels& labels = {})
+{
+    return Counter(detail::Registry::instance().series(name, help, detail::Type::Counter, labels));
+}
+
+inline Gauge gauge(std::string_view name, std::string_view help = {}, const Labels& labels = {})
+{
+    return Gauge(detail::Registry::instance().series(name, help, detail::Type::Gauge, labels));
+}
+
+// Bucket bounds are fixed by the first registration of 'name'
+inline Histogram histogram(std::string_view name, std::string_view help,
+    const std::vector<double>& bounds, const Labels& labels = {})
+{
+    return Histogram(detail::Registry::instance().series(name, help, detail::Type::Histogram, labels, &bounds));
+}
+
+// start, start*factor, ... ('count' bounds)
+inline std::vector<double> exponential_buckets(double start, double factor, int count)
+{
+    std::vector<double> b;
+    for (int i = 0; i < count; ++i) {
+        b.push_back(start * std::pow(factor, i));
+    }
+    return b;
+}
+
+inline std::vector<double> linear_buckets(double start, double width, int count)
+{
+    std::vector<double> b;
+    for (int i = 0; i < count; ++i) {
+        b.push_back(start + width * i);
+    }
+    return b;
+}
+
+// Metrics whose value is read when the registry is rendered
+[[nodiscard]] inline Registration counter_fn(std::string_view name, std::string_view help,
+    const Labels& labels, std::function<double()> read)
+{
+    return Registration(detail::Registry::instance().add_callback(name, help, detail::Type::Counter, labels, std::move(read)));
+}
+
+[[nodiscard]] inline Registration gauge_fn(std::string_view name, std::string_view help,
+    const Labels& labels, std::function<double()> read)
+{
+    return Registration(detail::Registry::instance().add_callback(name, help, detail::Type::Gauge, labels, std::move(read)));
+}
+
+// collect() runs before each render, e.g. to update metrics from a
+// snapshot. Series it registers are removed with the Registration.
+[[nodiscard]] inline Registration add_collector(std::function<void()> collect)
+{
+    return Registration(detail::Registry::instance().add_collector(std::move(collect)));
+}
+
+// --- Bridges to existing kitpp data ---
+
+// The logger's total() as counter <name>_total{logger="<label>"}
+template <typename Clock>
+[[nodiscard]] inline Registration expose(const BasicThroughputLogger<Clock>& logger,
+    std::string_view name = "kitpp_throughput_ops")
+{
+    return counter_fn(name, "Items counted by a kitpp ThroughputLogger", { { "logger", logger.label() } },
+        [&logger] { return static_cast<double>(logger.total()); });
+}
+
+// Aggregated timer statistics (stats::enable_aggregation()) as one
+// histogram series per call site, in seconds
+[[nodiscard]] inline Registration expose_timer_stats(std::string_view name = "kitpp_timer_seconds",
+    std::vector<double> bounds = exponential_buckets(1e-6, 4.0, 12))
+{
+    return add_collector([name = std::string(name), bounds = std::move(bounds)] {
+        for (const auto& site : stats::detail::Registry::instance().snapshot()) {
+            histogram(name, "Durations of kitpp timer call sites", bounds,
+                { { "site", site.label }, { "file", site.file }, { "line", std::to_string(site.line) } })
+                .assign(site.hist, 1e9);
+        }
+    });
+}
+
+// Peak resident set size (resource::get_max_rss_kb)
+[[nodiscard]] inline Registration expose_process()
+{
+    return gauge_fn("kitpp_process_max_rss_bytes", "Peak resident set size", {},
+        [] { return static_cast<double>(resource::get_max_rss_kb()) * 1024.0; });
+}
+
+// --- Export ---
+
+inline std::string render(Format format = Format::OpenMetrics)
+{
+    std::string out;
+    detail::Registry::instance().render(out, format);
+    return out;
+}
+
+inline void write(std::ostream& os, Format format = Format::OpenMetrics)
+{
+    os << render(format);
+}
+
+// Writes 'path' atomically: scrapers see the old or the new file, never
+// a partial one. node_exporter's textfile collector wants *.prom files in
+// the Prometheus format.
+inline bool write_textfile(const std::string& path, Format format = Format::Prometheus)
+{
+    const std::string text = render(format);
+    const std::string tmp = path + ".tmp." + std::to_string(kitpp::pid());
+    {
+        std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+        out << text;
+        out.flush();
+        if (!out) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+namespace detail {
+
+    // Background textfile writer and HTTP endpoint (one of each)
+    class Exporter {
+    public:
+        static Exporter& instance()
+        {
+            static Exporter exporter;
+            return exporter;
+        }
+
+        ~Exporter()
+        {
+            stop_textfile();
+            stop_http();
+        }
+
+        void start_textfile(std::string path, std::chrono::milliseconds interval, Format format)
+        {
+            stop_textfile();
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_textfile_ = false;
+            textfile_ = std::thread([this, path = std::move(path), interval, format] {
+                std::unique_lock<std::mutex> lk(mutex_);
+                do {
+                    lk.unlock();
+                    if (!write_textfile(path, format)) {
+                        KITPP_LOG_WARNF("metrics: could not write '{}'", path);
+                    }
+                    lk.lock();
+                } while (!cv_.wait_for(lk, interval, [this] { return stop_textfile_; }));
+                lk.unlock();
+                write_textfile(path, format); // Final values
+            });
+        }
+
+        void stop_textfile()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!textfile_.joinable()) {
+                    return;
+                }
+                stop_textfile_ = true;
+            }
+            cv_.notify_all();
+            textfile_.join();
+        }
+
+        int start_http(std::uint16_t port)
+        {
+            stop_http();
+#if KITPP_HAS_METRICS_HTTP
+            const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0) {
+                return -1;
+            }
+            const int one = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            sockaddr_in addr {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Never exposed beyond this host
+            addr.sin_port = htons(port);
+            socklen_t len = sizeof(addr);
+            if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+                || ::listen(fd, 16) != 0
+                || ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+                KITPP_LOG_WARNF("metrics: cannot listen on 127.0.0.1:{}: {}", port, std::strerror(errno));
+                ::close(fd);
+                return -1;
+            }
+            stop_http_.store(false, std::memory_order_relaxed);
+            http_ = std::thread([this, fd] { serve(fd); });
+            return ntohs(addr.sin_port);
+#else
+            (void)port;
+            return -1;
+#endif
+        }
+
+        void stop_http()
+        {
+            if (!http_.joinable()) {
+                return;
+            }
+            stop_http_.store(true, std::memory_order_relaxed);
+            http_.join();
+        }
+
+    private:
+        // Constructed first, so destroyed after the final write
+        Exporter()
+        {
+            Registry::instance();
+            stats::detail::Registry::instance();
+        }
+
+#if KITPP_HAS_METRICS_HTTP
+        // Polls so stop_http() is noticed within 100 ms; one request per connection
+        void serve(int fd)
+        {
+            while (!stop_http_.load(std::memory_order_relaxed)) {
+                pollfd p { fd, POLLIN, 0 };
+                if (::poll(&p, 1, 100) <= 0) {
+                    continue;
+                }
+                const int conn = ::accept(fd, nullptr, nullptr);
+                if (conn >= 0) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+                    const int one = 1; // macOS/BSD: no MSG_NOSIGNAL, so no SIGPIPE per socket
+                    ::setsockopt(conn, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+                    respond(conn);
+                    ::close(conn);
+                }
+            }
+            ::close(fd);
+        }
+
+        static void respond(int conn)
+        {
+            std::string request;
+            char buf[1024];
+            while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+                pollfd p { conn, POLLIN, 0 };
+                if (::poll(&p, 1, 1000) <= 0) {
+                    return;
+                }
+                const ssize_t n = ::recv(conn, buf, sizeof(buf), 0);
+                if (n <= 0) {
+                    return;
+                }
+                request.append(buf, static_cast<std::size_t>(n));
+            }
+
+            std::string response;
+            if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+                const bool om = request.find("application/openmetrics-text") != std::string::npos;
+                const std::string body = render(om ? Format::OpenMetrics : Format::Prometheus);
+                response = "HTTP/1.1 200 OK\r\nContent-Type: ";
+                response += om ? "application/openmetrics-text; version=1.0.0; charset=utf-8"
+                               : "text/plain; version=0.0.4; charset=utf-8";
+                response += "\r\nContent-Length: " + std::to_string(body.size());
+                response += "\r\nConnection: close\r\n\r\n";
+                response += body;
+            } else {
+                response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            }
+
+#if defined(MSG_NOSIGNAL)
+            constexpr int flags = MSG_NOSIGNAL; // A client that hung up must not kill the process
+#else
+            constexpr int flags = 0; // SO_NOSIGPIPE set in serve()
+#endif
+            std::size_t sent = 0;
+            while (sent < response.size()) {
+                const ssize_t n = ::send(conn, response.data() + sent, response.size() - sent, flags);
+                if (n <= 0) {
+                    return;
+                }
+                sent += static_cast<std::size_t>(n);
+            }
+        }
+#endif
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stop_textfile_ = false;
+        std::thread textfile_;
+        std::atomic<bool> stop_http_ { false };
+        std::thread http_;
+    };
+
+} // namespace detail
+
+// Rewrites 'path' every 'interval' (and once more when stopped or at exit)
+inline void start_textfile_exporter(std::string path,
+    std::chrono::milliseconds interval = std::chrono::seconds(15), Format format = Format::Prometheus)
+{
+    detail::Exporter::instance().start_textfile(std::move(path), interval, format);
+}
+
+inline void stop_textfile_exporter()
+{
+    detail::Exporter::instance().stop_textfile();
+}
+
+// Serves GET /metrics on 127.0.0.1:port (0 picks a free port). Returns the
+// port, or -1. Sends OpenMetrics when the scraper's Accept header asks for it.
+inline int start_http_endpoint(std::uint16_t port = 9464)
+{
+    return detail::Exporter::instance().start_http(port);
+}
+
+inline void stop_http_endpoint()
+{
+    detail::Exporter::instance().stop_http();
+}
+
+} // namespace kitpp::metrics
+
+#endif // KITPP_METRICS_HPP
@@ -0,0 +1,173 @@
+#ifndef KITPP_OMP_REGION_TIMER_HPP
+#define KITPP_OMP_REGION_TIMER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "../sys/clock.hpp"
+#include "../sys/platform.hpp" // For OpenMP checks/includes
+#include "log.hpp"
+#include "timer_stats.hpp"
+
+namespace kitpp {
+
+// --- OmpRegionTimer (Console, RAII, inside a parallel region) ---
+// Every thread of the team constructs one (the macro puts it in the
+// parallel block) and records its own busy time and CPU. The destructor
+// is a barrier: once all threads have finished their share, thread 0
+// reports min / mean / max busy time, the imbalance ratio (max / mean)
+// and the time threads spent waiting for the slowest one. Use
+// "omp for nowait" inside the region, otherwise the loop's own barrier
+// is counted as busy time.
+
+namespace detail {
+
+    constexpr int omp_region_max_threads = 512;
+
+    template <typename Clock>
+    struct alignas(64) OmpThreadSlot {
+        typename Clock::tick start {};
+        typename Clock::tick end {};
+        int cpu_start = -1;
+        int cpu_end = -1;
+    };
+
+    // One per call site, shared by the team (function-local static)
+    template <typename Clock = clocks::DefaultClock>
+    struct OmpRegionSite {
+        OmpThreadSlot<Clock> slots[omp_region_max_threads];
+    };
+
+    inline int omp_slot()
+    {
+        const int tid = kitpp::omp_tid();
+        return tid < 0 ? 0 : tid;
+    }
+
+} // namespace detail
+
+template <typename Clock = clocks::DefaultClock>
+class BasicOmpRegionTimer {
+public:
+    BasicOmpRegionTimer(detail::OmpRegionSite<Clock>& site, const char* label,
+        const char* file, int line, const char* func)
+        : site_(site)
+        , label_(label)
+        , file_(file)
+        , line_(line)
+        , func_(func)
+        , slot_(detail::omp_slot())
+    {
+        if (slot_ < detail::omp_region_max_threads) {
+            auto& s = site_.slots[slot_];
+            s.cpu_start = kitpp::cpu_index();
+            s.start = Clock::now();
+        }
+    }
+
+    ~BasicOmpRegionTimer()
+    {
+        if (slot_ < detail::omp_region_max_threads) {
+            auto& s = site_.slots[slot_];
+            s.end = Clock::now();
+            s.cpu_end = kitpp::cpu_index();
+        }
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+        if (slot_ == 0) {
+            report();
+        }
+        // Slots are reused by the next pass through this site
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+    }
+
+    BasicOmpRegionTimer(const BasicOmpRegionTimer&) = delete;
+    BasicOmpRegionTimer& operator=(const BasicOmpRegionTimer&) = delete;
+
+private:
+    static long long span_ns(typename Clock::tick from, typename Clock::tick to)
+    {
+        return to > from ? static_cast<long long>(Clock::to_ns(to - from)) : 0;
+    }
+
+    void report() const
+    {
+        const int team = std::min(kitpp::omp_team(), detail::omp_region_max_threads);
+        const auto* slots = site_.slots;
+
+        typename Clock::tick first = slots[0].start;
+        typename Clock::tick last = slots[0].end;
+        long long min_busy = span_ns(slots[0].start, slots[0].end);
+        long long max_busy = min_busy;
+        long long sum_busy = 0;
+        for (int t = 0; t < team; ++t) {
+            const long long busy = span_ns(slots[t].start, slots[t].end);
+            first = std::min(first, slots[t].start);
+            last = std::max(last, slots[t].end);
+            min_busy = std::min(min_busy, busy);
+            max_busy = std::max(max_busy, busy);
+            sum_busy += busy;
+        }
+        const long long wall = span_ns(first, last);
+
+        // Time each thread sat at the barrier waiting for the last one
+        long long sum_wait = 0;
+        for (int t = 0; t < team; ++t) {
+            sum_wait += span_ns(slots[t].end, last);
+        }
+
+        if (stats::aggregating()) {
+            stats::record(label_, file_, line_, func_, wall);
+            return;
+        }
+        if (!log::should_log(log::Level::Info)) {
+            return;
+        }
+
+        using log::detail::HumanDuration;
+        const double mean = static_cast<double>(sum_busy) / team;
+        const double imbalance = mean > 0.0 ? static_cast<double>(max_busy) / mean : 1.0;
+        const double wait_pct = wall > 0 ? 100.0 * static_cast<double>(sum_wait) / (static_cast<double>(wall) * team) : 0.0;
+        log::detail::logf_impl(log::Level::Info, file_, line_, func_,
+            "OmpRegion '{}' wall: {} | {} threads busy min {} / mean {} / max {} | imbalance {:.2} | barrier wait {} ({:.1}% of team time)",
+            label_, HumanDuration { static_cast<double>(wall) }, team,
+            HumanDuration { static_cast<double>(min_busy) }, HumanDuration { mean },
+            HumanDuration { static_cast<double>(max_busy) }, imbalance,
+            HumanDuration { static_cast<double>(sum_wait) }, wait_pct);
+
+        if (!log::should_log(log::Level::Debug)) {
+            return;
+        }
+        for (int t = 0; t < team; ++t) {
+            log::detail::logf_impl(log::Level::Debug, file_, line_, func_,
+                "OmpRegion '{}' thread {} cpu {}->{}: busy {}, wait {}",
+                label_, t, slots[t].cpu_start, slots[t].cpu_end,
+                HumanDuration { static_cast<double>(span_ns(slots[t].start, slots[t].end)) },
+                HumanDuration { static_cast<double>(span_ns(slots[t].end, last)) });
+        }
+    }
+
+    detail::OmpRegionSite<Clock>& site_;
+    const char* label_;
+    const char* file_;
+    int line_;
+    const char* func_;
+    int slot_;
+};
+
+using OmpRegionTimer = BasicOmpRegionTimer<>;
+
+} // namespace kitpp
+
+// Place at the top of a "#pragma omp parallel" block (label: string literal)
+#define KITPP_OMP_REGION_TIMER(label)                                              \
+    static kitpp::detail::OmpRegionSite<> KITPP_CONCAT(kitpp_omp_site_, __LINE__); \
+    kitpp::OmpRegionTimer KITPP_CONCAT(kitpp_omp_timer_, __LINE__)(                \
+        KITPP_CONCAT(kitpp_omp_site_, __LINE__), label, __FILE__, __LINE__, __func__)
+
+#endif // KITPP_OMP_REGION_TIMER_HPP
@@ -0,0 +1,194 @@
+#ifndef KITPP_PERF_SCOPE_HPP
+#define KITPP_PERF_SCOPE_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "../sys/clock.hpp"
+#include "../sys/perf_events.hpp"
+#include "../sys/platform.hpp"
+#include "csv_sink.hpp"
+#include "log.hpp"
+#include "timer_overhead.hpp"
+#include "TimerCommon.hpp"
+
+namespace kitpp {
+
+namespace detail::time {
+
+    // Shared sink behind KITPP_MEASURE_PERF_SCOPE; unavailable counters are empty
+    inline kitpp::log::CsvSink& perf_sink()
+    {
+        static kitpp::log::CsvSink sink("perf_tracker.csv",
+            "Timestamp,Scope,File,Function,Line,Duration_ns,Elements,Cycles,Instructions,IPC,"
+            "LLC_Misses,Branch_Misses,Task_Clock_ns,Page_Faults,Context_Switches,CPU_Migrations,"
+            "Running_Fraction");
+        return sink;
+    }
+
+    inline void log_perf_to_file(const std::string_view scope, long long duration_ns,
+        std::uint64_t elements, const perf::Counts& c,
+        const char* file, int line, const char* func)
+    {
+        perf_sink().append_row([&](std::string& out) {
+            using kitpp::log::detail::append_value;
+            out += timestamp_view();
+            out += ',';
+            out += scope;
+            out += ',';
+            out += file;
+            out += ',';
+            out += func;
+            out += ',';
+            append_value(out, line, {});
+            out += ',';
+            append_value(out, duration_ns, {});
+            out += ',';
+            append_value(out, elements, {});
+            auto field = [&](perf::Event e) {
+                out += ',';
+                if (c.has(e)) {
+                    append_value(out, static_cast<long long>(c[e]), {});
+                }
+            };
+            field(perf::Event::Cycles);
+            field(perf::Event::Instructions);
+            out += ',';
+            if (c.has(perf::Event::Cycles) && c.has(perf::Event::Instructions) && c[perf::Event::Cycles] > 0) {
+                append_value(out, c[perf::Event::Instructions] / c[perf::Event::Cycles], ".3");
+            }
+            field(perf::Event::LlcMisses);
+            field(perf::Event::BranchMisses);
+            field(perf::Event::TaskClock);
+            field(perf::Event::PageFaults);
+            field(perf::Event::ContextSwitches);
+            field(perf::Event::CpuMigrations);
+            out += ',';
+            append_value(out, c.running_fraction, ".3");
+            out += '\n';
+        });
+    }
+
+} // namespace detail::time
+
+// --- BasicPerfScope (Console [+ CSV], RAII) ---
+// ScopeTimer plus the thread's perf counter group (sys/perf_events.hpp),
+// read at entry and exit. Reports counter deltas, IPC and, when given an
+// element count, events per element. Without perf support only the time
+// is reported.
+template <typename Clock = clocks::DefaultClock>
+class BasicPerfScope {
+public:
+    struct WithElements { };
+
+    template <typename... Events>
+    BasicPerfScope(const char* file, int line, const char* func, bool to_file,
+        std::string label, Events... events)
+        : BasicPerfScope(file, line, func, to_file, WithElements {}, std::move(label), 0, events...)
+    {
+    }
+
+    template <typename... Events>
+    BasicPerfScope(const char* file, int line, const char* func, bool to_file,
+        WithElements, std::string label, std::uint64_t elements, Events... events)
+        : label_(std::move(label))
+        , file_(file)
+        , line_(line)
+        , func_(func)
+        , elements_(elements)
+        , to_file_(to_file)
+        , group_(perf::thread_group(perf::mask_of({ events... })))
+    {
+        group_.read(begin_);
+        start_time_ = Clock::now();
+    }
+
+    ~BasicPerfScope()
+    {
+        const long long ns = overhead::adjust<Clock>(Clock::to_ns(Clock::now() - start_time_));
+        perf::Reading end;
+        perf::Counts counts;
+        if (group_.read(end)) {
+            counts = group_.delta(begin_, end);
+        } else {
+            counts.valid = 0;
+        }
+
+        if (to_file_) {
+            detail::time::log_perf_to_file(label_, ns, elements_, counts, file_, line_, func_);
+        }
+        if (log::should_log(log::Level::Info)) {
+            report(ns, counts);
+        }
+    }
+
+    BasicPerfScope(const BasicPerfScope&) = delete;
+    BasicPerfScope& operator=(const BasicPerfScope&) = delete;
+
+private:
+    void report(long long ns, const perf::Counts& c) const
+    {
+        using log::detail::format_to;
+        std::string& buf = log::detail::format_buffer();
+        buf.clear();
+        format_to(buf, "PerfScope '{}' elapsed: {} ns ({})", label_, ns,
+            log::detail::HumanDuration { static_cast<double>(ns) });
+
+        for (int e = 0; e < perf::event_count; ++e) {
+            auto ev = static_cast<perf::Event>(e);
+            if (!c.has(ev)) {
+                continue;
+            }
+            format_to(buf, " {}={}", perf::event_name(ev), static_cast<long long>(c[ev]));
+            if (elements_ > 0 && ev != perf::Event::TaskClock) {
+                format_to(buf, " ({:.3}/elem)", c[ev] / static_cast<double>(elements_));
+            }
+        }
+        if (c.has(perf::Event::Cycles) && c.has(perf::Event::Instructions) && c[perf::Event::Cycles] > 0) {
+            format_to(buf, " IPC={:.2}", c[perf::Event::Instructions] / c[perf::Event::Cycles]);
+        }
+        if (c.valid == 0) {
+            buf += " [perf counters unavailable]";
+        } else if (group_.fell_back()) {
+            buf += " [no hardware counters, software events only]";
+        }
+        if (c.running_fraction < 1.0) {
+            format_to(buf, " [multiplexed, counted {:.0}%]", c.running_fraction * 100.0);
+        }
+        buf += overhead::note<Clock>();
+        log::detail::log_impl(log::Level::Info, buf, file_, line_, func_);
+    }
+
+    std::string label_;
+    const char* file_;
+    int line_;
+    const char* func_;
+    std::uint64_t elements_;
+    bool to_file_;
+    const perf::CounterGroup& group_;
+    perf::Reading begin_;
+    typename Clock::tick start_time_ {};
+};
+
+using PerfScope = BasicPerfScope<>;
+
+} // namespace kitpp
+
+// KITPP_PERF_SCOPE(label, events...): trailing arguments pick the events, e.g.
+// KITPP_PERF_SCOPE("dot", kitpp::perf::Event::Cycles, kitpp::perf::Event::LlcMisses);
+// none means cycles, instructions, LLC misses, branch misses and task-clock.
+
+#define KITPP_PERF_SCOPE(...) \
+    kitpp::PerfScope KITPP_CONCAT(kitpp_perf_scope_, __LINE__)(__FILE__, __LINE__, __func__, false, __VA_ARGS__)
+
+// KITPP_PERF_SCOPE_N(label, elements, events...): also reports events per
+// element for 'elements' items processed in the scope
+#define KITPP_PERF_SCOPE_N(...) \
+    kitpp::PerfScope KITPP_CONCAT(kitpp_perf_scope_, __LINE__)(__FILE__, __LINE__, __func__, false, kitpp::PerfScope::WithElements {}, __VA_ARGS__)
+
+// KITPP_MEASURE_PERF_SCOPE(label, elements, events...): console + perf_tracker.csv
+#define KITPP_MEASURE_PERF_SCOPE(...) \
+    kitpp::PerfScope KITPP_CONCAT(kitpp_perf_scope_, __LINE__)(__FILE__, __LINE__, __func__, true, kitpp::PerfScope::WithElements {}, __VA_ARGS__)
+
+#endif // KITPP_PERF_SCOPE_HPP
@@ -0,0 +1,104 @@
+#ifndef KITPP_LOG_RECORD_HPP
+#define KITPP_LOG_RECORD_HPP
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "../external/rang.hpp"
+
+namespace kitpp::log::detail {
+
+// What kind of line a record renders to
+enum class RecordKind {
+    Message, // INFO/WARNING/ERROR line
+    Var,     // KITPP_LOG_VAR line (message holds the value)
+    Thread   // KITPP_LOG_THREAD_CONTEXT line (message holds the formatted body)
+};
+
+// A single log line as seen by the writer. Non-owning: the synchronous
+// path renders straight from the caller's arguments.
+struct RecordView {
+    RecordKind kind = RecordKind::Message;
+    std::string_view level_str; // Always a string literal
+    rang::fg level_color = rang::fg::reset;
+    const char* file = "";
+    int line = 0;
+    const char* func = "";
+    std::string_view message;
+    std::string_view var_name;  // Var only
+    std::string_view type_name; // Var only
+};
+
+// Owning copy of a RecordView, so the line can be formatted later on
+// another thread (see async.hpp).
+struct Record {
+    Record() = default;
+    explicit Record(const RecordView& v)
+        : kind(v.kind)
+        , level_str(v.level_str)
+        , level_color(v.level_color)
+        , file(v.file)
+        , line(v.line)
+        , func(v.func)
+        , message(v.message)
+        , var_name(v.var_name)
+        , type_name(v.type_name)
+    {
+    }
+
+    RecordView view() const
+    {
+        return { kind, level_str, level_color, file, line, func, message, var_name, type_name };
+    }
+
+    RecordKind kind = RecordKind::Message;
+    std::string_view level_str;
+    rang::fg level_color = rang::fg::reset;
+    const char* file = "";
+    int line = 0;
+    const char* func = "";
+    std::string message;
+    std::string var_name;
+    std::string type_name;
+};
+
+// Renders a record exactly the way the synchronous logger always has
+inline void write_record(std::ostream& os, const RecordView& rec)
+{
+    switch (rec.kind) {
+    case RecordKind::Message:
+        os << rang::style::bold << rec.level_color << rec.level_str << "| "
+           << rang::style::reset << rang::style::bold
+           << "Source_File: " << rang::style::reset << rang::fg::red << rec.file
+           << rang::style::reset << '(' << rang::fgB::cyan << "L" << rec.line
+           << rang::style::reset << ")   `" << rang::fg::yellow << rec.func
+           << rang::style::reset << "`: " << rec.message << '\n';
+        break;
+
+    case RecordKind::Var:
+        os << rang::style::bold << rang::fg::magenta << "VAR     | "
+           << rang::style::reset << rang::style::bold
+           << "Source_File: " << rang::style::reset << rang::fg::red << rec.file
+           << rang::style::reset << '(' << rang::fgB::cyan << "L" << rec.line
+           << rang::style::reset << ")   `" << rang::fg::yellow << rec.func
+           << rang::style::reset << "`: " << rang::fg::magenta
+           << "Type: " << rang::style::reset << rang::fg::cyan
+           << rec.type_name << rang::style::reset << ", "
+           << rang::fg::magenta << "Name: " << rang::style::reset
+           << rang::fg::cyan << rec.var_name << rang::style::reset << ", "
+           << rang::fg::magenta << "Value: " << rang::style::reset
+           << rang::fg::cyan << rec.message << rang::style::reset << '\n';
+        break;
+
+    case RecordKind::Thread:
+        os << rang::style::bold << rang::fg::cyan << "THREAD  | " << rang::style::reset
+           << rec.message
+           << " @ " << rec.file << ":" << rec.line << " `" << rec.func << "`\n";
+        break;
+    }
+}
+
+} // namespace kitpp::log::detail
+
+#endif // KITPP_LOG_RECORD_HPP
@@ -0,0 +1,192 @@
+#ifndef KITPP_RESOURCE_SCOPE_HPP
+#define KITPP_RESOURCE_SCOPE_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <sys/resource.h> // POSIX specific
+
+#include "../sys/clock.hpp"
+#include "../sys/platform.hpp"
+#include "csv_sink.hpp"
+#include "log.hpp"
+#include "timer_overhead.hpp"
+#include "TimerCommon.hpp"
+
+namespace kitpp {
+
+namespace detail::time {
+
+    // getrusage() fields a ResourceScope reports
+    struct Usage {
+        std::int64_t user_us = 0;
+        std::int64_t sys_us = 0;
+        std::int64_t minor_faults = 0;
+        std::int64_t major_faults = 0;
+        std::int64_t voluntary_switches = 0;
+        std::int64_t involuntary_switches = 0;
+    };
+
+    // RUSAGE_THREAD is Linux-only; elsewhere the whole process is read
+    inline Usage read_usage(bool whole_process) noexcept
+    {
+#if defined(RUSAGE_THREAD)
+        const int who = whole_process ? RUSAGE_SELF : RUSAGE_THREAD;
+#else
+        (void)whole_process;
+        const int who = RUSAGE_SELF;
+#endif
+        Usage u;
+        struct rusage r;
+        if (getrusage(who, &r) == 0) {
+            u.user_us = static_cast<std::int64_t>(r.ru_utime.tv_sec) * 1000000 + r.ru_utime.tv_usec;
+            u.sys_us = static_cast<std::int64_t>(r.ru_stime.tv_sec) * 1000000 + r.ru_stime.tv_usec;
+            u.minor_faults = r.ru_minflt;
+            u.major_faults = r.ru_majflt;
+            u.voluntary_switches = r.ru_nvcsw;
+            u.involuntary_switches = r.ru_nivcsw;
+        }
+        return u;
+    }
+
+    inline kitpp::log::CsvSink& resource_sink()
+    {
+        static kitpp::log::CsvSink sink("resource_tracker.csv",
+            "Timestamp,Scope,File,Function,Line,Duration_ns,User_us,Sys_us,CPU_Fraction,"
+            "Minor_Faults,Major_Faults,Voluntary_CS,Involuntary_CS,Whole_Process");
+        return sink;
+    }
+
+    inline void log_resource_to_file(const std::string_view scope, long long duration_ns, const Usage& d,
+        bool whole_process, const char* file, int line, const char* func)
+    {
+        resource_sink().append_row([&](std::string& out) {
+            using kitpp::log::detail::append_value;
+            out += timestamp_view();
+            out += ',';
+            out += scope;
+            out += ',';
+            out += file;
+            out += ',';
+            out += func;
+            out += ',';
+            append_value(out, line, {});
+            out += ',';
+            append_value(out, duration_ns, {});
+            out += ',';
+            append_value(out, static_cast<long long>(d.user_us), {});
+            out += ',';
+            append_value(out, static_cast<long long>(d.sys_us), {});
+            out += ',';
+            if (duration_ns > 0) {
+                append_value(out, (d.user_us + d.sys_us) * 1000.0 / static_cast<double>(duration_ns), ".3");
+            }
+            for (std::int64_t v : { d.minor_faults, d.major_faults, d.voluntary_switches, d.involuntary_switches }) {
+                out += ',';
+                append_value(out, static_cast<long long>(v), {});
+            }
+            out += whole_process ? ",1\n" : ",0\n";
+        });
+    }
+
+} // namespace detail::time
+
+// --- BasicResourceScope (Console [+ CSV], RAII) ---
+// ScopeTimer plus getrusage() at entry and exit: wall time against
+// user+sys CPU time, minor/major page faults and voluntary/involuntary
+// context switches spent in the scope. A low CPU share with many
+// voluntary switches means the scope waited (I/O, locks); many
+// involuntary ones mean it was preempted; a high sys share with minor
+// faults is usually first-touch of fresh memory.
+// By default only the calling thread is measured (RUSAGE_THREAD), so work
+// handed to an OpenMP team inside the scope is not counted; use the
+// _PROCESS macro for that (other threads' unrelated work is then counted).
+template <typename Clock = clocks::DefaultClock>
+class BasicResourceScope {
+public:
+    BasicResourceScope(std::string label, const char* file, int line, const char* func,
+        bool to_file = false, bool whole_process = false)
+        : label_(std::move(label))
+        , file_(file)
+        , line_(line)
+        , func_(func)
+        , to_file_(to_file)
+        , whole_process_(whole_process)
+        , begin_(detail::time::read_usage(whole_process))
+    {
+        start_time_ = Clock::now();
+    }
+
+    ~BasicResourceScope()
+    {
+        const long long ns = overhead::adjust<Clock>(Clock::to_ns(Clock::now() - start_time_));
+        const detail::time::Usage end = detail::time::read_usage(whole_process_);
+        detail::time::Usage d;
+        d.user_us = end.user_us - begin_.user_us;
+        d.sys_us = end.sys_us - begin_.sys_us;
+        d.minor_faults = end.minor_faults - begin_.minor_faults;
+        d.major_faults = end.major_faults - begin_.major_faults;
+        d.voluntary_switches = end.voluntary_switches - begin_.voluntary_switches;
+        d.involuntary_switches = end.involuntary_switches - begin_.involuntary_switches;
+
+        if (to_file_) {
+            detail::time::log_resource_to_file(label_, ns, d, whole_process_, file_, line_, func_);
+        }
+        if (log::should_log(log::Level::Info)) {
+            report(ns, d);
+        }
+    }
+
+    BasicResourceScope(const BasicResourceScope&) = delete;
+    BasicResourceScope& operator=(const BasicResourceScope&) = delete;
+
+private:
+    void report(long long ns, const detail::time::Usage& d) const
+    {
+        using log::detail::format_to;
+        using log::detail::HumanDuration;
+        std::string& buf = log::detail::format_buffer();
+        buf.clear();
+        format_to(buf, "ResourceScope '{}' elapsed: {} ns ({}) cpu: {} user + {} sys", label_, ns,
+            HumanDuration { static_cast<double>(ns) }, HumanDuration { d.user_us * 1000.0 },
+            HumanDuration { d.sys_us * 1000.0 });
+        if (ns > 0) {
+            format_to(buf, " ({:.1}% of wall)", (d.user_us + d.sys_us) * 1e5 / static_cast<double>(ns));
+        }
+        format_to(buf, " faults: {} minor, {} major; context switches: {} voluntary, {} involuntary",
+            static_cast<long long>(d.minor_faults), static_cast<long long>(d.major_faults),
+            static_cast<long long>(d.voluntary_switches), static_cast<long long>(d.involuntary_switches));
+        if (whole_process_) {
+            buf += " [whole process]";
+        }
+        buf += overhead::note<Clock>();
+        log::detail::log_impl(log::Level::Info, buf, file_, line_, func_);
+    }
+
+    std::string label_;
+    const char* file_;
+    int line_;
+    const char* func_;
+    bool to_file_;
+    bool whole_process_;
+    detail::time::Usage begin_;
+    typename Clock::tick start_time_ {};
+};
+
+using ResourceScope = BasicResourceScope<>;
+
+} // namespace kitpp
+
+#define KITPP_RESOURCE_SCOPE(label) \
+    kitpp::ResourceScope KITPP_CONCAT(kitpp_resource_scope_, __LINE__)(label, __FILE__, __LINE__, __func__)
+
+// Counts every thread of the process (e.g. a scope around an OpenMP region)
+#define KITPP_RESOURCE_SCOPE_PROCESS(label) \
+    kitpp::ResourceScope KITPP_CONCAT(kitpp_resource_scope_, __LINE__)(label, __FILE__, __LINE__, __func__, false, true)
+
+// Console + resource_tracker.csv
+#define KITPP_MEASURE_RESOURCE_SCOPE(label) \
+    kitpp::ResourceScope KITPP_CONCAT(kitpp_resource_scope_, __LINE__)(label, __FILE__, __LINE__, __func__, true)
+
+#endif // KITPP_RESOURCE_SCOPE_HPP
@@ -0,0 +1,73 @@
+#ifndef KITPP_LOG_SAMPLING_HPP
+#define KITPP_LOG_SAMPLING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace kitpp::log::detail {
+
+// --- Per-Call-Site Samplers ---
+// Each sampled macro owns one of these as a function-local static
+// (constant-initialized, no guard). should_emit() decides whether this
+// call prints and how many calls were skipped since the previous line.
+
+// Emits calls 0, n, 2n, ...: one relaxed fetch_add per call
+struct EveryNSampler {
+    std::atomic<std::uint64_t> count { 0 };
+
+    bool should_emit(std::uint64_t n, std::uint64_t& suppressed)
+    {
+        const std::uint64_t c = count.fetch_add(1, std::memory_order_relaxed);
+        if (n <= 1) {
+            suppressed = 0;
+            return true;
+        }
+        if (c % n != 0) {
+            return false;
+        }
+        suppressed = c == 0 ? 0 : n - 1;
+        return true;
+    }
+};
+
+// Emits the first n calls, then goes quiet: one relaxed load once saturated
+struct FirstNSampler {
+    std::atomic<std::uint64_t> count { 0 };
+
+    bool should_emit(std::uint64_t n, std::uint64_t& suppressed)
+    {
+        if (count.load(std::memory_order_relaxed) >= n) {
+            return false;
+        }
+        suppressed = 0;
+        return count.fetch_add(1, std::memory_order_relaxed) < n;
+    }
+};
+
+// Emits at most once per interval. A skipped call reads the clock and does
+// one relaxed fetch_add on the suppressed counter.
+struct EveryMsSampler {
+    std::atomic<std::int64_t> next_ns { 0 };
+    std::atomic<std::uint64_t> skipped { 0 };
+
+    bool should_emit(std::int64_t interval_ms, std::uint64_t& suppressed)
+    {
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+                                     .count();
+        std::int64_t due = next_ns.load(std::memory_order_relaxed);
+        if (now < due
+            || !next_ns.compare_exchange_strong(due, now + interval_ms * 1000000,
+                std::memory_order_relaxed)) {
+            skipped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = skipped.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+} // namespace kitpp::log::detail
+
+#endif // KITPP_LOG_SAMPLING_HPP
@@ -0,0 +1,345 @@
+#ifndef KITPP_SCOPE_PROFILER_HPP
+#define KITPP_SCOPE_PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "format.hpp"
+
+namespace kitpp::profile {
+
+// --- Hierarchical Scope Profiler ---
+// With profiling enabled, every ScopeTimer also enters a node of its
+// thread's call tree (child of the innermost open ScopeTimer). Nodes keep
+// call count, inclusive time and the time spent in child scopes, so
+// exclusive time is inclusive minus children. Trees from all threads are
+// merged by path when reported. Scopes opened on worker threads have no
+// parent there, so they show up as roots of their own.
+
+namespace detail {
+
+    constexpr std::uint32_t no_node = 0xffffffffu;
+
+    struct Node {
+        std::string label;
+        const char* file = "";
+        int line = 0;
+        std::uint32_t parent = no_node;
+
+        std::uint64_t count = 0;
+        std::int64_t inclusive_ns = 0;
+        std::int64_t children_ns = 0;
+        std::vector<std::uint32_t> children;
+    };
+
+    // One per thread. nodes[0] is a virtual root; 'current' is the top of
+    // the scope stack (walk 'parent' links for the rest of it).
+    struct ThreadTree {
+        std::mutex mutex; // Only contended while a report merges
+        std::vector<Node> nodes;
+        std::uint32_t current = 0;
+
+        ThreadTree()
+        {
+            nodes.reserve(64);
+            nodes.emplace_back();
+        }
+
+        void enter(std::string_view label, const char* file, int line)
+        {
+            for (std::uint32_t idx : nodes[current].children) {
+                const Node& n = nodes[idx];
+                if (n.line == line && n.file == file && n.label == label) {
+                    current = idx;
+                    return;
+                }
+            }
+            auto idx = static_cast<std::uint32_t>(nodes.size());
+            Node node;
+            node.label.assign(label.data(), label.size());
+            node.file = file;
+            node.line = line;
+            node.parent = current;
+            nodes.push_back(std::move(node));
+            nodes[current].children.push_back(idx);
+            current = idx;
+        }
+
+        void leave(std::int64_t ns)
+        {
+            if (current == 0) {
+                return; // Unbalanced leave (profiling reset mid-scope)
+            }
+            ns = std::max<std::int64_t>(ns, 0);
+            Node& node = nodes[current];
+            ++node.count;
+            node.inclusive_ns += ns;
+            current = node.parent;
+            nodes[current].children_ns += ns;
+        }
+    };
+
+    // Thread-independent tree used for reports
+    struct MergedNode {
+        std::string label;
+        std::string file;
+        int line = 0;
+        std::uint64_t count = 0;
+        std::int64_t inclusive_ns = 0;
+        std::int64_t children_ns = 0;
+        std::vector<MergedNode> children;
+
+        std::int64_t exclusive_ns() const { return std::max<std::int64_t>(inclusive_ns - children_ns, 0); }
+    };
+
+    inline void merge_into(MergedNode& dst, const ThreadTree& tree, std::uint32_t idx)
+    {
+        for (std::uint32_t child_idx : tree.nodes[idx].children) {
+            const Node& src = tree.nodes[child_idx];
+            auto it = std::find_if(dst.children.begin(), dst.children.end(), [&src](const MergedNode& m) {
+                return m.line == src.line && m.label == src.label && m.file == src.file;
+            });
+            if (it == dst.children.end()) {
+                MergedNode m;
+                m.label = src.label;
+                m.file = src.file;
+                m.line = src.line;
+                dst.children.push_back(std::move(m));
+                it = dst.children.end() - 1;
+            }
+            it->count += src.count;
+            it->inclusive_ns += src.inclusive_ns;
+            it->children_ns += src.children_ns;
+            merge_into(*it, tree, child_idx);
+        }
+    }
+
+    inline void sort_by_inclusive(MergedNode& node)
+    {
+        std::sort(node.children.begin(), node.children.end(), [](const MergedNode& a, const MergedNode& b) {
+            return a.inclusive_ns > b.inclusive_ns;
+        });
+        for (auto& child : node.children) {
+            sort_by_inclusive(child);
+        }
+    }
+
+    class Registry {
+    public:
+        static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        std::atomic<bool> enabled { false };
+        std::atomic<bool> report_at_exit { false };
+
+        ThreadTree& thread_tree()
+        {
+            thread_local std::shared_ptr<ThreadTree> tree;
+            if (!tree) {
+                tree = std::make_shared<ThreadTree>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                trees_.push_back(tree);
+            }
+            return *tree;
+        }
+
+        // Root of the merged tree (no label), children sorted by inclusive time
+        MergedNode merged(std::size_t* threads = nullptr)
+        {
+            std::vector<std::shared_ptr<ThreadTree>> trees;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                trees = trees_;
+            }
+            MergedNode root;
+            for (auto& tree : trees) {
+                std::lock_guard<std::mutex> lock(tree->mutex);
+                merge_into(root, *tree, 0);
+            }
+            for (const auto& child : root.children) {
+                root.inclusive_ns += child.inclusive_ns;
+            }
+            sort_by_inclusive(root);
+            if (threads != nullptr) {
+                *threads = trees.size();
+            }
+            return root;
+        }
+
+        // Zeroes the counters but keeps the nodes, so open scopes stay valid
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& tree : trees_) {
+                std::lock_guard<std::mutex> tree_lock(tree->mutex);
+                for (auto& node : tree->nodes) {
+                    node.count = 0;
+                    node.inclusive_ns = 0;
+                    node.children_ns = 0;
+                }
+            }
+        }
+
+        std::string folded_path;
+
+    private:
+        Registry() = default;
+
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadTree>> trees_;
+    };
+
+    inline void print_node(std::ostream& os, const MergedNode& node, std::int64_t total, int depth)
+    {
+        using kitpp::log::detail::append_value;
+        using kitpp::log::detail::HumanDuration;
+        std::string incl, excl;
+        append_value(incl, HumanDuration { static_cast<double>(node.inclusive_ns) }, {});
+        append_value(excl, HumanDuration { static_cast<double>(node.exclusive_ns()) }, {});
+        double pct = total > 0 ? 100.0 * static_cast<double>(node.inclusive_ns) / static_cast<double>(total) : 0.0;
+
+        os << std::setw(11) << incl << std::setw(11) << excl
+           << std::setw(11) << node.count
+           << std::setw(7) << std::fixed << std::setprecision(1) << pct << '%'
+           << "  " << std::string(static_cast<std::size_t>(depth) * 2, ' ') << node.label
+           << "  (" << node.file << ':' << node.line << ")\n";
+        for (const auto& child : node.children) {
+            print_node(os, child, total, depth + 1);
+        }
+    }
+
+    // Folded-stack frames may not contain ';' or line breaks
+    inline void append_frame(std::string& out, std::string_view label)
+    {
+        for (char c : label) {
+            out += (c == ';' || c == '\n' || c == '\r') ? '_' : c;
+        }
+    }
+
+    inline void write_folded_node(std::ostream& os, const MergedNode& node, std::string& path)
+    {
+        const std::size_t len = path.size();
+        if (!path.empty()) {
+            path += ';';
+        }
+        append_frame(path, node.label);
+        if (node.exclusive_ns() > 0) {
+            os << path << ' ' << node.exclusive_ns() << '\n';
+        }
+        for (const auto& child : node.children) {
+            write_folded_node(os, child, path);
+        }
+        path.resize(len);
+    }
+
+} // namespace detail
+
+inline bool enabled()
+{
+    return detail::Registry::instance().enabled.load(std::memory_order_relaxed);
+}
+
+// Called by ScopeTimer; pairs with leave() on the same thread
+inline void enter(std::string_view label, const char* file, int line)
+{
+    detail::ThreadTree& tree = detail::Registry::instance().thread_tree();
+    std::lock_guard<std::mutex> lock(tree.mutex);
+    tree.enter(label, file, line);
+}
+
+inline void leave(std::int64_t ns)
+{
+    detail::ThreadTree& tree = detail::Registry::instance().thread_tree();
+    std::lock_guard<std::mutex> lock(tree.mutex);
+    tree.leave(ns);
+}
+
+// Indented call tree of all threads, children sorted by inclusive time
+inline void print_tree(std::ostream& os = std::clog)
+{
+    std::size_t threads = 0;
+    detail::MergedNode root = detail::Registry::instance().merged(&threads);
+
+    os << "--- kitpp scope profile (" << threads << " threads) ---\n";
+    os << std::right << std::setw(11) << "Inclusive" << std::setw(11) << "Exclusive"
+       << std::setw(11) << "Count" << std::setw(8) << "%Total" << "  Scope\n";
+    for (const auto& child : root.children) {
+        detail::print_node(os, child, root.inclusive_ns, 0);
+    }
+    os.unsetf(std::ios::floatfield);
+    os << std::setprecision(6);
+    os.flush();
+}
+
+// One "outer;inner <exclusive ns>" line per tree path, as read by
+// flamegraph.pl and speedscope
+inline void write_folded(std::ostream& os)
+{
+    detail::MergedNode root = detail::Registry::instance().merged();
+    std::string path;
+    for (const auto& child : root.children) {
+        detail::write_folded_node(os, child, path);
+    }
+    os.flush();
+}
+
+inline bool write_folded(const std::string& path)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    write_folded(out);
+    return static_cast<bool>(out);
+}
+
+// Starts building call trees from ScopeTimers. With report_at_exit the
+// tree is printed to std::clog at exit; a non-empty folded_path also gets
+// the folded stacks written there.
+inline void enable_profiling(bool report_at_exit = true, std::string folded_path = {})
+{
+    auto& reg = detail::Registry::instance();
+    reg.folded_path = std::move(folded_path);
+    reg.report_at_exit.store(report_at_exit, std::memory_order_relaxed);
+    reg.enabled.store(true, std::memory_order_relaxed);
+
+    static const bool registered = (std::atexit([] {
+        auto& r = detail::Registry::instance();
+        if (r.report_at_exit.load(std::memory_order_relaxed)) {
+            print_tree();
+        }
+        if (!r.folded_path.empty() && !write_folded(r.folded_path)) {
+            std::clog << "kitpp: cannot write folded stacks to " << r.folded_path << '\n';
+        }
+    }), true);
+    (void)registered;
+}
+
+inline void disable_profiling()
+{
+    detail::Registry::instance().enabled.store(false, std::memory_order_relaxed);
+}
+
+// Clears all collected times and counts
+inline void reset()
+{
+    detail::Registry::instance().reset();
+}
+
+} // namespace kitpp::profile
+
+#endif // KITPP_SCOPE_PROFILER_HPP
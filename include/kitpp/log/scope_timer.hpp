@@ -1,78 +1,157 @@
 #ifndef KITPP_SCOPE_TIMER_HPP
 #define KITPP_SCOPE_TIMER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
+#include "../sys/clock.hpp"
 #include "../sys/platform.hpp" // For OpenMP checks/includes
 #include "log.hpp"
+#include "scope_profiler.hpp"
+#include "timer_overhead.hpp"
+#include "timer_stats.hpp"
+#include "trace_sink.hpp"
 #include "TimerCommon.hpp"
 
 namespace kitpp {
 
-// --- ScopeTimer (Console Only, RAII) ---
-class ScopeTimer {
+// --- BasicScopeTimer (Console Only, RAII) ---
+// Clock is a policy from sys/clock.hpp; ScopeTimer uses the default one.
+// While profiling (scope_profiler.hpp) it is also a node of the call tree.
+template <typename Clock = clocks::DefaultClock>
+class BasicScopeTimer {
 public:
     // Accepts location info to log correctly
-    ScopeTimer(std::string label, const char* file, int line, const char* func)
+    BasicScopeTimer(std::string label, const char* file, int line, const char* func)
         : label_(std::move(label))
         , file_(file)
         , line_(line)
         , func_(func)
+        , profiled_(profile::enabled())
     {
-#if defined(_OPENMP)
-        start_time_ = ::omp_get_wtime();
-#else
-        start_time_ = std::chrono::steady_clock::now();
-#endif
+        if (profiled_) {
+            profile::enter(label_, file_, line_);
+        }
+        start_time_ = Clock::now();
     }
 
-    ~ScopeTimer()
+    ~BasicScopeTimer()
     {
-        long long us = get_elapsed_us();
-        std::string msg = "ScopeTimer '" + label_ + "' elapsed: " + std::to_string(us) + " us";
-        log::detail::log_impl("INFO    ", rang::fg::cyan, msg, file_, line_, func_);
+        const long long ns = get_elapsed_ns();
+        if (profiled_) {
+            profile::leave(ns);
+        }
+        if (trace::enabled()) {
+            trace::record(label_, file_, line_, ns);
+        }
+        if (stats::aggregating()) {
+            stats::record(label_, file_, line_, func_, ns);
+            return;
+        }
+        if (!log::should_log(log::Level::Info)) {
+            return;
+        }
+        log::detail::logf_impl(log::Level::Info, file_, line_, func_,
+            "ScopeTimer '{}' elapsed: {} ns ({}){}", label_, ns, log::detail::HumanDuration { static_cast<double>(ns) },
+            overhead::note<Clock>());
     }
 
+    BasicScopeTimer(const BasicScopeTimer&) = delete;
+    BasicScopeTimer& operator=(const BasicScopeTimer&) = delete;
+
 protected:
+    long long get_elapsed_ns() const
+    {
+        return overhead::adjust<Clock>(Clock::to_ns(Clock::now() - start_time_));
+    }
+
     long long get_elapsed_us() const
     {
-#if defined(_OPENMP)
-        return static_cast<long long>((::omp_get_wtime() - start_time_) * 1e6);
-#else
-        auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::microseconds>(now - start_time_).count();
-#endif
+        return get_elapsed_ns() / 1000;
     }
 
     std::string label_;
     const char* file_;
     int line_;
     const char* func_;
-#if defined(_OPENMP)
-    double start_time_;
-#else
-    std::chrono::time_point<std::chrono::steady_clock> start_time_;
-#endif
+    bool profiled_;
+    typename Clock::tick start_time_ {};
 };
 
-// --- ScopeTimerFile (Console + CSV, RAII) ---
-class ScopeTimerFile : public ScopeTimer {
+// --- BasicScopeTimerFile (Console + CSV, RAII) ---
+template <typename Clock = clocks::DefaultClock>
+class BasicScopeTimerFile : public BasicScopeTimer<Clock> {
 public:
-    ScopeTimerFile(std::string label, const char* file, int line, const char* func)
-        : ScopeTimer(std::move(label), file, line, func)
+    BasicScopeTimerFile(std::string label, const char* file, int line, const char* func)
+        : BasicScopeTimer<Clock>(std::move(label), file, line, func)
     {
     }
 
-    ~ScopeTimerFile()
+    ~BasicScopeTimerFile()
     {
-        long long us = get_elapsed_us();
-        detail::time::log_time_to_file(label_, us, file_, line_, func_);
+        long long ns = this->get_elapsed_ns();
+        detail::time::log_time_to_file(this->label_, ns, this->file_, this->line_, this->func_);
         // Base destructor logs to console
     }
 };
 
+using ScopeTimer = BasicScopeTimer<>;
+using ScopeTimerFile = BasicScopeTimerFile<>;
+
+// --- SampledScopeTimer (Console, RAII, 1-in-N) ---
+// Only every Nth entry into the scope is timed. Skipped entries cost one
+// relaxed fetch_add on the call site's counter and never copy the label.
+template <typename Clock = clocks::DefaultClock>
+class BasicSampledScopeTimer {
+public:
+    BasicSampledScopeTimer(std::atomic<std::uint64_t>& counter, std::uint64_t every,
+        std::string_view label, const char* file, int line, const char* func)
+        : file_(file)
+        , line_(line)
+        , func_(func)
+    {
+        const std::uint64_t c = counter.fetch_add(1, std::memory_order_relaxed);
+        if (every > 1 && c % every != 0) {
+            return;
+        }
+        active_ = true;
+        every_ = every;
+        suppressed_ = (c == 0 || every <= 1) ? 0 : every - 1;
+        label_.assign(label.data(), label.size());
+        start_time_ = Clock::now();
+    }
+
+    ~BasicSampledScopeTimer()
+    {
+        if (!active_ || !log::should_log(log::Level::Info)) {
+            return;
+        }
+        const long long ns = overhead::adjust<Clock>(Clock::to_ns(Clock::now() - start_time_));
+        log::detail::logf_impl(log::Level::Info, file_, line_, func_,
+            "ScopeTimer '{}' elapsed: {} ns ({}) [sampled 1/{}, {} suppressed]{}",
+            label_, ns, log::detail::HumanDuration { static_cast<double>(ns) }, every_, suppressed_,
+            overhead::note<Clock>());
+    }
+
+    BasicSampledScopeTimer(const BasicSampledScopeTimer&) = delete;
+    BasicSampledScopeTimer& operator=(const BasicSampledScopeTimer&) = delete;
+
+private:
+    std::string label_;
+    const char* file_;
+    int line_;
+    const char* func_;
+    bool active_ = false;
+    std::uint64_t every_ = 1;
+    std::uint64_t suppressed_ = 0;
+    typename Clock::tick start_time_ {};
+};
+
+using SampledScopeTimer = BasicSampledScopeTimer<>;
+
 } // namespace kitpp
 
 // Macros to capture location in C++17
@@ -83,4 +162,10 @@ public:
 #define KITPP_MEASURE_SCOPE(label) \
     kitpp::ScopeTimerFile kitpp_file_timer_##__LINE__(label, __FILE__, __LINE__, __func__)
 
+// Times one in every 'every' passes through the scope
+#define KITPP_SCOPE_TIMER_SAMPLED(label, every)                                             \
+    static std::atomic<std::uint64_t> KITPP_CONCAT(kitpp_sampled_counter_, __LINE__) { 0 }; \
+    kitpp::SampledScopeTimer KITPP_CONCAT(kitpp_sampled_timer_, __LINE__)(                  \
+        KITPP_CONCAT(kitpp_sampled_counter_, __LINE__), every, label, __FILE__, __LINE__, __func__)
+
 #endif // KITPP_SCOPE_TIMER_HPP
\ No newline at end of file
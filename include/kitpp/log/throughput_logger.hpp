@@ -1,67 +1,233 @@
 #ifndef KITPP_THROUGHPUT_LOGGER_HPP
 #define KITPP_THROUGHPUT_LOGGER_HPP
 
+#include "../sys/clock.hpp"
 #include "../sys/platform.hpp" // For OpenMP checks/includes
+#include "../sys/thread_info.hpp"
+#include "histogram.hpp"
 #include "log.hpp"
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace kitpp {
 
-class ThroughputLogger {
+namespace detail {
+
+    // Dense per-thread number used to pick a counter shard
+    inline unsigned thread_shard_index()
+    {
+        return kitpp::thread_info().index;
+    }
+
+    // Smallest power of two >= n (at least 1, at most 4096)
+    inline unsigned shard_count_for(unsigned n)
+    {
+        unsigned p = 1;
+        while (p < n && p < 4096) {
+            p *= 2;
+        }
+        return p;
+    }
+
+    // One shard per hardware thread (8..256)
+    inline unsigned default_shard_count()
+    {
+        unsigned hw = std::thread::hardware_concurrency();
+        return shard_count_for(hw < 8 ? 8 : (hw > 256 ? 256 : hw));
+    }
+
+} // namespace detail
+
+// --- ThroughputLogger ---
+// add(n) may be called from any number of threads: each thread adds to
+// its own cache-line-padded shard (one uncontended relaxed fetch_add).
+// report() sums the shards and logs the rate since the previous report,
+// an exponentially weighted moving average and the rate since
+// construction; start_reporter() does that from a background thread.
+// Each report's rate also goes into rate_histogram(), so the spread of
+// interval rates (e.g. p1 / p50) can be queried or exported.
+// record(total) keeps the original single-threaded interface.
+template <typename Clock = clocks::DefaultClock>
+class BasicThroughputLogger {
 public:
-    explicit ThroughputLogger(std::string label)
+    explicit BasicThroughputLogger(std::string label, unsigned shards = detail::default_shard_count())
         : label_(std::move(label))
         , last_ops_(0)
+        , shard_mask_(detail::shard_count_for(shards) - 1)
+        , shards_(new Shard[shard_mask_ + 1])
+        , start_time_(Clock::now())
+        , last_record_time_(start_time_)
+        , last_report_time_(start_time_)
+    {
+    }
+
+    ~BasicThroughputLogger()
+    {
+        stop_reporter();
+    }
+
+    BasicThroughputLogger(const BasicThroughputLogger&) = delete;
+    BasicThroughputLogger& operator=(const BasicThroughputLogger&) = delete;
+
+    // Hot path: count n more items (thread-safe)
+    void add(std::uint64_t n = 1)
+    {
+        shards_[detail::thread_shard_index() & shard_mask_].count.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    const std::string& label() const
     {
-#if defined(_OPENMP)
-        start_time_ = ::omp_get_wtime();
-#else
-        start_time_ = std::chrono::steady_clock::now();
-#endif
+        return label_;
     }
 
-    // Renamed 'log' to 'record'
+    // Items added so far, summed over all shards
+    std::uint64_t total() const
+    {
+        std::uint64_t sum = 0;
+        for (unsigned i = 0; i <= shard_mask_; ++i) {
+            sum += shards_[i].count.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    // Time constant of the moving average (default 5 s)
+    void set_ewma_window(std::chrono::milliseconds window)
+    {
+        std::lock_guard<std::mutex> lock(report_mutex_);
+        ewma_window_sec_ = std::chrono::duration<double>(window).count();
+    }
+
+    // Logs the rates of the items counted with add()
+    void report()
+    {
+        // Read under the lock: concurrent reports then see totals and times
+        // in the same order, so the difference never wraps
+        std::lock_guard<std::mutex> lock(report_mutex_);
+        const std::uint64_t now_total = total();
+        const auto now = Clock::now();
+        const double dt = seconds(last_report_time_, now);
+        const double elapsed = seconds(start_time_, now);
+        if (dt <= 0.0 || elapsed <= 0.0) {
+            return;
+        }
+        const double instant = static_cast<double>(now_total - last_report_total_) / dt;
+        if (!ewma_valid_) {
+            ewma_ = instant;
+            ewma_valid_ = true;
+        } else {
+            const double alpha = 1.0 - std::exp(-dt / ewma_window_sec_);
+            ewma_ += alpha * (instant - ewma_);
+        }
+        last_report_total_ = now_total;
+        last_report_time_ = now;
+        rates_.record(static_cast<std::int64_t>(instant));
+
+        KITPP_LOG_INFOF("ThroughputLogger '{}': {:.6} ops/sec now, {:.6} ops/sec EWMA, {:.6} ops/sec overall ({} total)",
+            label_, instant, ewma_, static_cast<double>(now_total) / elapsed, now_total);
+    }
+
+    // Distribution of the ops/sec values logged by report()
+    const stats::Histogram& rate_histogram() const
+    {
+        return rates_;
+    }
+
+    // Calls report() every 'interval' on a background thread
+    void start_reporter(std::chrono::milliseconds interval)
+    {
+        std::lock_guard<std::mutex> lock(reporter_mutex_);
+        if (reporter_.joinable()) {
+            return;
+        }
+        stop_requested_ = false;
+        reporter_ = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lk(reporter_mutex_);
+            while (!reporter_cv_.wait_for(lk, interval, [this] { return stop_requested_; })) {
+                lk.unlock();
+                report();
+                lk.lock();
+            }
+        });
+    }
+
+    void stop_reporter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(reporter_mutex_);
+            if (!reporter_.joinable()) {
+                return;
+            }
+            stop_requested_ = true;
+        }
+        reporter_cv_.notify_all();
+        reporter_.join();
+    }
+
+    // Single-threaded interface: logs the average rate since construction
+    // and the rate since the previous record() call
     void record(long long operations_completed)
     {
-        double elapsed_sec = 0.0;
-#if defined(_OPENMP)
-        elapsed_sec = ::omp_get_wtime() - start_time_;
-#else
-        auto now = std::chrono::steady_clock::now();
-        elapsed_sec = std::chrono::duration<double>(now - start_time_).count();
-#endif
-
-        // Calculate delta since last record if you want interval throughput,
-        // or total throughput. Based on your usage, you are passing total items.
-        // Let's assume you want instantaneous throughput (ops/sec) for the total time.
-        // Or if you want interval:
-        // long long delta_ops = operations_completed - last_ops_;
-        // But start_time_ is constructed at start.
-        // So this calculates "Average throughput since start".
+        const auto now = Clock::now();
+        const double elapsed_sec = seconds(start_time_, now);
+        const double interval_sec = seconds(last_record_time_, now);
 
         if (elapsed_sec > 0) {
             double ops_per_sec = static_cast<double>(operations_completed) / elapsed_sec;
-            KITPP_LOG_INFO("ThroughputLogger '" + label_ + "': " + std::to_string(ops_per_sec) + " ops/sec");
+            if (interval_sec > 0) {
+                double interval_rate = static_cast<double>(operations_completed - last_ops_) / interval_sec;
+                KITPP_LOG_INFOF("ThroughputLogger '{}': {:.6} ops/sec (interval: {:.6} ops/sec)", label_, ops_per_sec, interval_rate);
+            } else {
+                KITPP_LOG_INFOF("ThroughputLogger '{}': {:.6} ops/sec", label_, ops_per_sec);
+            }
         } else {
-            KITPP_LOG_INFO("ThroughputLogger '" + label_ + "': Elapsed time too short to calculate ops/sec.");
+            KITPP_LOG_INFOF("ThroughputLogger '{}': Elapsed time too short to calculate ops/sec.", label_);
         }
 
-        // If you want interval-based throughput (resetting timer), uncomment below:
-        // start_time_ = ...;
-        // last_ops_ = operations_completed;
+        last_record_time_ = now;
+        last_ops_ = operations_completed;
     }
 
 private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> count { 0 };
+    };
+
+    static double seconds(typename Clock::tick from, typename Clock::tick to)
+    {
+        return to > from ? static_cast<double>(Clock::to_ns(to - from)) / 1e9 : 0.0;
+    }
+
     std::string label_;
     long long last_ops_;
-#if defined(_OPENMP)
-    double start_time_;
-#else
-    std::chrono::time_point<std::chrono::steady_clock> start_time_;
-#endif
+    const unsigned shard_mask_;
+    std::unique_ptr<Shard[]> shards_;
+
+    typename Clock::tick start_time_;
+    typename Clock::tick last_record_time_;
+
+    std::mutex report_mutex_; // Guards the report state below
+    typename Clock::tick last_report_time_;
+    std::uint64_t last_report_total_ = 0;
+    double ewma_ = 0.0;
+    bool ewma_valid_ = false;
+    double ewma_window_sec_ = 5.0;
+    stats::Histogram rates_ { 1, std::int64_t(1) << 50, 2 };
+
+    std::mutex reporter_mutex_;
+    std::condition_variable reporter_cv_;
+    bool stop_requested_ = false;
+    std::thread reporter_;
 };
 
+using ThroughputLogger = BasicThroughputLogger<>;
+
 } // namespace kitpp
 
 #endif // KITPP_THROUGHPUT_LOGGER_HPP
@@ -0,0 +1,144 @@
+#ifndef KITPP_TIMER_OVERHEAD_HPP
+#define KITPP_TIMER_OVERHEAD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "../sys/clock.hpp"
+#include "format.hpp"
+
+namespace kitpp::overhead {
+
+// --- Timer Overhead Calibration ---
+// An empty scope does not time as zero: the interval between the start
+// and stop clock reads is part of every reported duration. calibrate<Clock>()
+// measures that bias as the median of many back-to-back now() pairs. It is
+// kept per clock, not per timer type: every timer reads the clock last on
+// entry and first on exit, so the reads are what falls inside the interval
+// and timers sharing a clock share its bias. Once a clock is calibrated
+// the timers print the bias next to their results, and with subtraction
+// enabled (enable_subtraction() or KITPP_TIMER_OVERHEAD=subtract) they
+// report durations minus the bias, clamped at zero.
+// The cost a timer adds to the code *around* it (label copy, logging,
+// CSV) is larger; examples/timer_overhead_benchmark.cpp measures it.
+
+namespace detail {
+
+    template <typename Clock>
+    struct ClockBias {
+        static inline std::atomic<std::int64_t> ns { -1 }; // -1: not calibrated
+    };
+
+    inline std::atomic<int>& subtract_flag()
+    {
+        // -1: not yet read from the environment
+        static std::atomic<int> flag { -1 };
+        return flag;
+    }
+
+    inline bool subtract_from_env()
+    {
+        const char* env = std::getenv("KITPP_TIMER_OVERHEAD");
+        return env != nullptr && std::string_view(env) == "subtract";
+    }
+
+} // namespace detail
+
+// Measures (or re-measures) the empty-interval bias of Clock
+template <typename Clock = clocks::DefaultClock>
+inline std::int64_t calibrate(int samples = 2001)
+{
+    constexpr int max_samples = 4001;
+    std::int64_t ns[max_samples];
+    samples = std::clamp(samples, 1, max_samples);
+
+    for (int i = 0; i < 1000; ++i) { // Warm up caches and the TSC calibration
+        (void)Clock::now();
+    }
+    for (int i = 0; i < samples; ++i) {
+        auto start = Clock::now();
+        auto stop = Clock::now();
+        ns[i] = stop > start ? static_cast<std::int64_t>(Clock::to_ns(stop - start)) : 0;
+    }
+    std::nth_element(ns, ns + samples / 2, ns + samples);
+    const std::int64_t bias = ns[samples / 2];
+    detail::ClockBias<Clock>::ns.store(bias, std::memory_order_relaxed);
+    return bias;
+}
+
+// Calibrates every clock policy in sys/clock.hpp
+inline void calibrate_all()
+{
+    calibrate<clocks::SteadyClock>();
+    calibrate<clocks::OmpClock>();
+    calibrate<clocks::TscClock>();
+}
+
+template <typename Clock = clocks::DefaultClock>
+inline bool calibrated()
+{
+    return detail::ClockBias<Clock>::ns.load(std::memory_order_relaxed) >= 0;
+}
+
+// Calibrated bias of Clock, 0 if it has not been calibrated
+template <typename Clock = clocks::DefaultClock>
+inline std::int64_t bias_ns()
+{
+    return std::max<std::int64_t>(detail::ClockBias<Clock>::ns.load(std::memory_order_relaxed), 0);
+}
+
+inline bool subtracting()
+{
+    int flag = detail::subtract_flag().load(std::memory_order_relaxed);
+    if (flag < 0) {
+        flag = detail::subtract_from_env() ? 1 : 0;
+        detail::subtract_flag().store(flag, std::memory_order_relaxed);
+    }
+    return flag == 1;
+}
+
+// Subtract the bias from reported durations. Calibrates every clock now,
+// so the measurement does not land inside a timed region later.
+inline void enable_subtraction(bool on = true)
+{
+    if (on) {
+        calibrate_all();
+    }
+    detail::subtract_flag().store(on ? 1 : 0, std::memory_order_relaxed);
+}
+
+// Applied by the timers to every raw duration
+template <typename Clock>
+inline std::int64_t adjust(std::int64_t raw_ns)
+{
+    if (!subtracting()) {
+        return raw_ns;
+    }
+    if (!calibrated<Clock>()) {
+        calibrate<Clock>(); // First use via the environment variable
+    }
+    return std::max<std::int64_t>(raw_ns - bias_ns<Clock>(), 0);
+}
+
+// " [timer overhead 25 ns]" (or "..., subtracted]") once Clock is
+// calibrated, else empty. Points into a thread-local buffer.
+template <typename Clock>
+inline std::string_view note()
+{
+    if (!calibrated<Clock>()) {
+        return {};
+    }
+    thread_local std::string buf;
+    buf.clear();
+    kitpp::log::detail::format_to(buf, " [timer overhead {} ns{}]", bias_ns<Clock>(),
+        subtracting() ? ", subtracted" : "");
+    return buf;
+}
+
+} // namespace kitpp::overhead
+
+#endif // KITPP_TIMER_OVERHEAD_HPP
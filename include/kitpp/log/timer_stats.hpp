@@ -0,0 +1,322 @@
+#ifndef KITPP_TIMER_STATS_HPP
+#define KITPP_TIMER_STATS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "format.hpp"
+#include "histogram.hpp"
+#include "timer_overhead.hpp"
+
+namespace kitpp::stats {
+
+// --- Aggregating Timer Statistics ---
+// With aggregation enabled, ScopeTimer / ManualTimer stop printing one line
+// per scope and instead feed running statistics for their call site
+// (label + file + line). Each thread updates its own shard; shards are
+// merged when a report is printed (on demand or at exit).
+
+namespace detail {
+
+    struct SiteStats {
+        std::string label;
+        const char* file = "";
+        int line = 0;
+        const char* func = "";
+
+        std::uint64_t count = 0;
+        double total_ns = 0.0;
+        double sum_sq = 0.0;
+        std::int64_t min_ns = std::numeric_limits<std::int64_t>::max();
+        std::int64_t max_ns = 0;
+        // 1 ns .. 1 ms at 2 significant digits (14 KiB instead of 36 KiB
+        // for the full hour), widened when a longer duration arrives
+        static constexpr std::int64_t initial_highest_ns = 1000000;
+        static constexpr std::int64_t max_highest_ns = 3600LL * 1000000000LL;
+        Histogram hist { 1, initial_highest_ns, 2 };
+
+        // Grows hist (by doublings, up to 1 h) until it covers ns
+        void fit(std::int64_t ns)
+        {
+            std::int64_t highest = hist.highest();
+            if (ns <= highest || highest >= max_highest_ns) {
+                return;
+            }
+            while (highest < ns && highest < max_highest_ns) {
+                highest *= 2;
+            }
+            Histogram wider(hist.lowest(), std::min(highest, max_highest_ns), hist.significant_digits());
+            wider.merge(hist);
+            hist.swap(wider);
+        }
+
+        void add(std::int64_t ns)
+        {
+            ns = std::max<std::int64_t>(ns, 0);
+            fit(ns);
+            ++count;
+            total_ns += static_cast<double>(ns);
+            sum_sq += static_cast<double>(ns) * static_cast<double>(ns);
+            min_ns = std::min(min_ns, ns);
+            max_ns = std::max(max_ns, ns);
+            hist.record(ns);
+        }
+
+        void merge(const SiteStats& other)
+        {
+            count += other.count;
+            total_ns += other.total_ns;
+            sum_sq += other.sum_sq;
+            min_ns = std::min(min_ns, other.min_ns);
+            max_ns = std::max(max_ns, other.max_ns);
+            fit(other.hist.max());
+            hist.merge(other.hist);
+        }
+    };
+
+    // One per thread. The mutex is only contended while a report merges.
+    struct ThreadShard {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, std::unique_ptr<SiteStats>> sites;
+    };
+
+    inline std::uint64_t site_key(std::string_view label, const char* file, int line)
+    {
+        std::uint64_t h = std::hash<std::string_view> {}(label);
+        h ^= reinterpret_cast<std::uintptr_t>(file) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= static_cast<std::uint64_t>(line) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    class Registry {
+    public:
+        static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        std::atomic<bool> enabled { false };
+        std::atomic<bool> report_at_exit { false };
+
+        void record(std::string_view label, const char* file, int line, const char* func, std::int64_t ns)
+        {
+            ThreadShard& shard = thread_shard();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            std::uint64_t key = site_key(label, file, line);
+            for (;;) {
+                auto it = shard.sites.find(key);
+                if (it == shard.sites.end()) {
+                    auto site = std::make_unique<SiteStats>();
+                    site->label.assign(label.data(), label.size());
+                    site->file = file;
+                    site->line = line;
+                    site->func = func;
+                    site->add(ns);
+                    shard.sites.emplace(key, std::move(site));
+                    return;
+                }
+                SiteStats& site = *it->second;
+                if (site.line == line && site.file == file && site.label == label) {
+                    site.add(ns);
+                    return;
+                }
+                ++key; // Hash collision: probe the next key
+            }
+        }
+
+        // Merges every thread's shard; call sites are matched by text,
+        // so the same header location seen from two TUs is one row
+        std::vector<SiteStats> snapshot()
+        {
+            std::vector<std::shared_ptr<ThreadShard>> shards;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                shards = shards_;
+            }
+            std::map<std::tuple<std::string, int, std::string>, SiteStats> merged;
+            for (auto& shard : shards) {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                for (auto& entry : shard->sites) {
+                    const SiteStats& s = *entry.second;
+                    auto key = std::make_tuple(std::string(s.file), s.line, s.label);
+                    auto it = merged.find(key);
+                    if (it == merged.end()) {
+                        merged.emplace(std::move(key), s);
+                    } else {
+                        it->second.merge(s);
+                    }
+                }
+            }
+            std::vector<SiteStats> out;
+            out.reserve(merged.size());
+            for (auto& entry : merged) {
+                out.push_back(std::move(entry.second));
+            }
+            return out;
+        }
+
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& shard : shards_) {
+                std::lock_guard<std::mutex> shard_lock(shard->mutex);
+                shard->sites.clear();
+            }
+        }
+
+    private:
+        Registry() = default;
+
+        ThreadShard& thread_shard()
+        {
+            thread_local std::shared_ptr<ThreadShard> shard;
+            if (!shard) {
+                shard = std::make_shared<ThreadShard>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                shards_.push_back(shard);
+            }
+            return *shard;
+        }
+
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadShard>> shards_;
+    };
+
+    // "12.3 us" style, picking the unit by magnitude
+    inline std::string format_ns(double ns)
+    {
+        std::string out;
+        kitpp::log::detail::append_value(out, kitpp::log::detail::HumanDuration { ns }, {});
+        return out;
+    }
+
+} // namespace detail
+
+// Prints the merged per-call-site table, sorted by total time (flat profile)
+inline void print_report(std::ostream& os = std::clog)
+{
+    std::vector<detail::SiteStats> sites = detail::Registry::instance().snapshot();
+    std::sort(sites.begin(), sites.end(), [](const detail::SiteStats& a, const detail::SiteStats& b) {
+        return a.total_ns > b.total_ns;
+    });
+
+    double grand_total = 0.0;
+    for (const auto& s : sites) {
+        grand_total += s.total_ns;
+    }
+
+    using detail::format_ns;
+    os << "--- kitpp timer statistics (" << sites.size() << " call sites) ---\n";
+    if (overhead::calibrated()) {
+        os << "Timer overhead: " << overhead::bias_ns() << " ns per measurement"
+           << (overhead::subtracting() ? " (subtracted)\n" : " (included)\n");
+    }
+    os << std::left << std::setw(28) << "Scope" << std::right
+       << std::setw(7) << "%Total" << std::setw(11) << "Count"
+       << std::setw(11) << "Total" << std::setw(11) << "Mean"
+       << std::setw(11) << "StdDev" << std::setw(11) << "Min"
+       << std::setw(11) << "p50" << std::setw(11) << "p90"
+       << std::setw(11) << "p99" << std::setw(11) << "p99.9" << std::setw(11) << "Max"
+       << "  Location\n";
+
+    for (const auto& s : sites) {
+        // Bucket upper bounds can overshoot the observed range
+        auto pct_at = [&s](double q) {
+            return std::clamp(static_cast<double>(s.hist.value_at_percentile(q * 100.0)),
+                static_cast<double>(s.min_ns), static_cast<double>(s.max_ns));
+        };
+        double mean = s.total_ns / static_cast<double>(s.count);
+        double var = s.sum_sq / static_cast<double>(s.count) - mean * mean;
+        double stddev = var > 0.0 ? std::sqrt(var) : 0.0;
+        double pct = grand_total > 0.0 ? 100.0 * s.total_ns / grand_total : 0.0;
+
+        os << std::left << std::setw(28) << s.label << std::right
+           << std::setw(6) << std::fixed << std::setprecision(1) << pct << '%'
+           << std::setw(11) << s.count
+           << std::setw(11) << format_ns(s.total_ns)
+           << std::setw(11) << format_ns(mean)
+           << std::setw(11) << format_ns(stddev)
+           << std::setw(11) << format_ns(static_cast<double>(s.min_ns))
+           << std::setw(11) << format_ns(pct_at(0.50))
+           << std::setw(11) << format_ns(pct_at(0.90))
+           << std::setw(11) << format_ns(pct_at(0.99))
+           << std::setw(11) << format_ns(pct_at(0.999))
+           << std::setw(11) << format_ns(static_cast<double>(s.max_ns))
+           << "  " << s.file << ':' << s.line << '\n';
+    }
+    os.unsetf(std::ios::floatfield);
+    os << std::setprecision(6);
+    os.flush();
+}
+
+// Switches ScopeTimer / ManualTimer to aggregation. With report_at_exit
+// the table is printed to std::clog when the process exits.
+inline void enable_aggregation(bool report_at_exit = true)
+{
+    auto& reg = detail::Registry::instance();
+    reg.report_at_exit.store(report_at_exit, std::memory_order_relaxed);
+    reg.enabled.store(true, std::memory_order_relaxed);
+
+    // Function-local static init is thread-safe: the hook is added exactly once
+    static const bool registered = (std::atexit([] {
+        if (detail::Registry::instance().report_at_exit.load(std::memory_order_relaxed)) {
+            print_report();
+        }
+    }), true);
+    (void)registered;
+}
+
+inline void disable_aggregation()
+{
+    detail::Registry::instance().enabled.store(false, std::memory_order_relaxed);
+}
+
+inline bool aggregating()
+{
+    return detail::Registry::instance().enabled.load(std::memory_order_relaxed);
+}
+
+// Adds one measurement for a call site (used by the timers)
+inline void record(std::string_view label, const char* file, int line, const char* func, std::int64_t ns)
+{
+    detail::Registry::instance().record(label, file, line, func, ns);
+}
+
+// Merged duration histogram (ns) of every call site with this label,
+// e.g. for Histogram::write_percentiles(); empty if there is none
+inline Histogram site_histogram(std::string_view label)
+{
+    Histogram out;
+    for (const auto& s : detail::Registry::instance().snapshot()) {
+        if (s.label == label) {
+            out.merge(s.hist);
+        }
+    }
+    return out;
+}
+
+// Clears all collected statistics
+inline void reset()
+{
+    detail::Registry::instance().reset();
+}
+
+} // namespace kitpp::stats
+
+#endif // KITPP_TIMER_STATS_HPP
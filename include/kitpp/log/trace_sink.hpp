@@ -0,0 +1,314 @@
+#ifndef KITPP_TRACE_SINK_HPP
+#define KITPP_TRACE_SINK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../sys/clock.hpp"
+#include "../sys/platform.hpp"
+#include "../sys/thread_info.hpp"
+#include "format.hpp"
+#include "timer_stats.hpp"
+
+namespace kitpp::trace {
+
+// --- Chrome Trace Event Sink ---
+// While tracing, every ScopeTimer / ManualTimer interval is stored as one
+// complete ("X") event: begin timestamp + duration, pid, OS tid, omp_tid()
+// and cpu_index() at the end of the interval. Events go into per-thread
+// chunks of preallocated storage (a new chunk is allocated only when one
+// fills up) and are written as JSON by stop_tracing() or at exit.
+// The file loads in chrome://tracing and ui.perfetto.dev.
+
+namespace detail {
+
+    struct Event {
+        std::int64_t begin_ns; // Relative to start_tracing()
+        std::int64_t dur_ns;
+        std::uint32_t name;    // Index into ThreadBuffer::names
+        std::int32_t omp_tid;
+        std::int32_t cpu;
+    };
+
+    struct Name {
+        std::string label;
+        const char* file;
+        int line;
+    };
+
+    // One per thread. The mutex is only contended while the file is written.
+    struct ThreadBuffer {
+        std::mutex mutex;
+        long tid = 0;
+        std::string name; // Thread name when the buffer was created
+        std::vector<std::unique_ptr<Event[]>> chunks;
+        std::size_t chunk_events = 0;
+        std::size_t used = 0; // Events in the last chunk
+        std::vector<Name> names;
+        std::unordered_map<std::uint64_t, std::uint32_t> name_ids;
+
+        void add_chunk()
+        {
+            chunks.emplace_back(new Event[chunk_events]);
+            used = 0;
+        }
+
+        std::uint32_t name_id(std::string_view label, const char* file, int line)
+        {
+            std::uint64_t key = kitpp::stats::detail::site_key(label, file, line);
+            for (;;) {
+                auto it = name_ids.find(key);
+                if (it == name_ids.end()) {
+                    auto id = static_cast<std::uint32_t>(names.size());
+                    names.push_back(Name { std::string(label), file, line });
+                    name_ids.emplace(key, id);
+                    return id;
+                }
+                const Name& n = names[it->second];
+                if (n.line == line && n.file == file && n.label == label) {
+                    return it->second;
+                }
+                ++key; // Hash collision: probe the next key
+            }
+        }
+
+        void add(const Event& e)
+        {
+            if (chunks.empty() || used == chunk_events) {
+                add_chunk();
+            }
+            chunks.back()[used++] = e;
+        }
+
+        void clear()
+        {
+            if (chunks.size() > 1) {
+                chunks.resize(1); // Keep the first chunk for the next run
+            }
+            used = 0;
+        }
+    };
+
+    class Registry {
+    public:
+        static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        std::atomic<bool> enabled { false };
+        std::atomic<std::int64_t> epoch_ns { 0 };
+        std::atomic<std::size_t> chunk_events { 1 << 15 };
+
+        ThreadBuffer& thread_buffer()
+        {
+            thread_local std::shared_ptr<ThreadBuffer> buf;
+            if (!buf) {
+                buf = std::make_shared<ThreadBuffer>();
+                buf->tid = kitpp::thread_info().tid;
+                buf->name = kitpp::thread_name();
+                buf->chunk_events = chunk_events.load(std::memory_order_relaxed);
+                buf->names.reserve(64);
+                buf->add_chunk();
+                std::lock_guard<std::mutex> lock(mutex_);
+                buffers_.push_back(buf);
+            }
+            return *buf;
+        }
+
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return buffers_;
+        }
+
+        std::mutex path_mutex;
+        std::string path;
+
+    private:
+        Registry() = default;
+
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    };
+
+    inline void append_json_string(std::string& out, std::string_view s)
+    {
+        out += '"';
+        for (char c : s) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += ' ';
+                } else {
+                    out += c;
+                }
+            }
+        }
+        out += '"';
+    }
+
+    inline void append_event(std::string& out, const ThreadBuffer& buf, const Event& e, int pid)
+    {
+        using kitpp::log::detail::append_value;
+        const Name& name = buf.names[e.name];
+        out += ",\n{\"name\":";
+        append_json_string(out, name.label);
+        out += ",\"cat\":\"kitpp\",\"ph\":\"X\",\"ts\":";
+        append_value(out, static_cast<double>(e.begin_ns) / 1000.0, ".3");
+        out += ",\"dur\":";
+        append_value(out, static_cast<double>(e.dur_ns) / 1000.0, ".3");
+        out += ",\"pid\":";
+        append_value(out, pid, {});
+        out += ",\"tid\":";
+        append_value(out, buf.tid, {});
+        out += ",\"args\":{\"omp_tid\":";
+        append_value(out, e.omp_tid, {});
+        out += ",\"cpu\":";
+        append_value(out, e.cpu, {});
+        out += ",\"file\":";
+        append_json_string(out, name.file);
+        out += ",\"line\":";
+        append_value(out, name.line, {});
+        out += "}}";
+    }
+
+    // Writes (and clears) every thread's events
+    inline bool write_json(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        const int pid = kitpp::pid();
+        std::string text;
+        text.reserve(1 << 16);
+        text += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        text += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":";
+        kitpp::log::detail::append_value(text, pid, {});
+        text += ",\"args\":{\"name\":\"kitpp\"}}";
+
+        // Names set after a thread's first event still apply while it lives
+        const std::vector<ThreadInfo> live = kitpp::live_threads();
+
+        for (auto& buf : Registry::instance().buffers()) {
+            std::lock_guard<std::mutex> lock(buf->mutex);
+            int omp_tid = -1;
+            for (std::size_t c = 0; c < buf->chunks.size(); ++c) {
+                std::size_t n = (c + 1 == buf->chunks.size()) ? buf->used : buf->chunk_events;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const Event& e = buf->chunks[c][i];
+                    omp_tid = e.omp_tid;
+                    append_event(text, *buf, e, pid);
+                }
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                text.clear();
+            }
+            // Thread label shown in the viewer's left column
+            text += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+            kitpp::log::detail::format_to(text, "{},\"tid\":{},\"args\":{{\"name\":", pid, buf->tid);
+            std::string label = buf->name;
+            for (const ThreadInfo& t : live) {
+                if (t.tid == buf->tid) {
+                    label = t.name_view();
+                }
+            }
+            if (!label.empty()) {
+                label += ' ';
+            }
+            if (omp_tid >= 0) {
+                kitpp::log::detail::format_to(label, "omp {} ", omp_tid);
+            }
+            kitpp::log::detail::format_to(label, "(tid {})", buf->tid);
+            append_json_string(text, label);
+            text += "}}";
+            buf->clear();
+        }
+        text += "\n]}\n";
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return static_cast<bool>(out);
+    }
+
+} // namespace detail
+
+inline bool enabled()
+{
+    return detail::Registry::instance().enabled.load(std::memory_order_relaxed);
+}
+
+// Adds one interval that ended now and lasted 'ns' (used by the timers)
+inline void record(std::string_view label, const char* file, int line, std::int64_t ns)
+{
+    const std::int64_t end = clocks::SteadyClock::now();
+    auto& reg = detail::Registry::instance();
+    detail::ThreadBuffer& buf = reg.thread_buffer();
+    const std::int32_t omp = kitpp::omp_tid();
+    const std::int32_t cpu = kitpp::cpu_index();
+
+    std::lock_guard<std::mutex> lock(buf.mutex);
+    detail::Event e;
+    e.begin_ns = end - ns - reg.epoch_ns.load(std::memory_order_relaxed);
+    e.dur_ns = ns;
+    e.name = buf.name_id(label, file, line);
+    e.omp_tid = omp;
+    e.cpu = cpu;
+    buf.add(e);
+}
+
+// Allocates the calling thread's buffer now rather than at its first
+// event, e.g. once per thread in a parallel region before the timed loop
+inline void reserve_thread()
+{
+    detail::Registry::instance().thread_buffer();
+}
+
+// Writes the collected events to the trace file and stops tracing
+inline bool stop_tracing()
+{
+    auto& reg = detail::Registry::instance();
+    if (!reg.enabled.exchange(false)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(reg.path_mutex);
+    if (!detail::write_json(reg.path)) {
+        std::clog << "kitpp: cannot write trace to " << reg.path << '\n';
+        return false;
+    }
+    return true;
+}
+
+// Starts recording timer intervals for 'path' (written by stop_tracing()
+// or at exit). chunk_events is the per-thread preallocation, in events.
+inline void start_tracing(std::string path, std::size_t chunk_events = 1 << 15)
+{
+    auto& reg = detail::Registry::instance();
+    {
+        std::lock_guard<std::mutex> lock(reg.path_mutex);
+        reg.path = std::move(path);
+    }
+    reg.chunk_events.store(chunk_events > 0 ? chunk_events : 1, std::memory_order_relaxed);
+    reg.epoch_ns.store(clocks::SteadyClock::now(), std::memory_order_relaxed);
+    reg.enabled.store(true, std::memory_order_relaxed);
+
+    static const bool registered = (std::atexit([] { stop_tracing(); }), true);
+    (void)registered;
+}
+
+} // namespace kitpp::trace
+
+#endif // KITPP_TRACE_SINK_HPP
@@ -1,16 +1,25 @@
+#ifndef KITPP_DAXPY_HPP
+#define KITPP_DAXPY_HPP
+
 #include <chrono>
+#include <cstddef>
 #include <immintrin.h>
 #include <iomanip>
 #include <iostream>
-#include <omp.h>
 #include <vector>
 
+#include "../memory/aligned_buffer.hpp"
+#include "../sys/platform.hpp" // For OpenMP checks/includes
+
 namespace kitpp::math {
 
-void axpy_scalar(double alpha, const std::vector<double>& x, std::vector<double>& y)
+// y[i] += alpha * x[i] for i < n
+inline void axpy_scalar(double alpha, const double* __restrict__ x, double* __restrict__ y, size_t n)
 {
-#pragma omp parallel for
-    for (size_t i = 0; i < y.size(); ++i) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_t i = 0; i < n; ++i) {
         y[i] += alpha * x[i];
     }
 }
@@ -20,14 +29,15 @@ void axpy_scalar(double alpha, const std::vector<double>& x, std::vector<double>
 // - Use AVX2 FMA (Fused Multiply-Add) to do 4 operations at once.
 // - Unroll loop 4x (16 elements) to pipeline memory requests.
 // - Use OpenMP for multi-core memory saturation.
-void axpy_avx(double alpha, const std::vector<double>& x, std::vector<double>& y)
+// Needs AVX2 + FMA (own target attribute); kitpp::math::axpy() dispatches.
+KITPP_TARGET("avx2,fma") inline void axpy_avx(double alpha, const double* __restrict__ x, double* __restrict__ y, size_t n)
 {
-    size_t n = y.size();
-
     // Broadcast alpha to a vector: [alpha, alpha, alpha, alpha]
     __m256d v_alpha = _mm256_set1_pd(alpha);
 
+#if defined(_OPENMP)
 #pragma omp parallel for schedule(static)
+#endif
     for (size_t i = 0; i < n; i += 16) {
         // Handle boundary cleanup for non-multiples of 16
         if (i + 15 >= n) {
@@ -39,16 +49,16 @@ void axpy_avx(double alpha, const std::vector<double>& x, std::vector<double>& y
 
         // Unroll 4x (Process 16 elements per step)
         // 1. Load X
-        __m256d x0 = _mm256_loadu_pd(&x[i]);
-        __m256d x1 = _mm256_loadu_pd(&x[i + 4]);
-        __m256d x2 = _mm256_loadu_pd(&x[i + 8]);
-        __m256d x3 = _mm256_loadu_pd(&x[i + 12]);
+        __m256d x0 = _mm256_loadu_pd(x + i);
+        __m256d x1 = _mm256_loadu_pd(x + i + 4);
+        __m256d x2 = _mm256_loadu_pd(x + i + 8);
+        __m256d x3 = _mm256_loadu_pd(x + i + 12);
 
         // 2. Load Y
-        __m256d y0 = _mm256_loadu_pd(&y[i]);
-        __m256d y1 = _mm256_loadu_pd(&y[i + 4]);
-        __m256d y2 = _mm256_loadu_pd(&y[i + 8]);
-        __m256d y3 = _mm256_loadu_pd(&y[i + 12]);
+        __m256d y0 = _mm256_loadu_pd(y + i);
+        __m256d y1 = _mm256_loadu_pd(y + i + 4);
+        __m256d y2 = _mm256_loadu_pd(y + i + 8);
+        __m256d y3 = _mm256_loadu_pd(y + i + 12);
 
         // 3. FMA: y = (alpha * x) + y
         y0 = _mm256_fmadd_pd(v_alpha, x0, y0);
@@ -57,11 +67,36 @@ void axpy_avx(double alpha, const std::vector<double>& x, std::vector<double>& y
         y3 = _mm256_fmadd_pd(v_alpha, x3, y3);
 
         // 4. Store Y
-        _mm256_storeu_pd(&y[i], y0);
-        _mm256_storeu_pd(&y[i + 4], y1);
-        _mm256_storeu_pd(&y[i + 8], y2);
-        _mm256_storeu_pd(&y[i + 12], y3);
+        _mm256_storeu_pd(y + i, y0);
+        _mm256_storeu_pd(y + i + 4, y1);
+        _mm256_storeu_pd(y + i + 8, y2);
+        _mm256_storeu_pd(y + i + 12, y3);
     }
 }
 
+// --- Container overloads ---
+// y.size() elements; x must hold at least as many
+
+inline void axpy_scalar(double alpha, const std::vector<double>& x, std::vector<double>& y)
+{
+    axpy_scalar(alpha, x.data(), y.data(), y.size());
+}
+
+inline void axpy_avx(double alpha, const std::vector<double>& x, std::vector<double>& y)
+{
+    axpy_avx(alpha, x.data(), y.data(), y.size());
 }
+
+inline void axpy_scalar(double alpha, const memory::AlignedBuffer<double>& x, memory::AlignedBuffer<double>& y)
+{
+    axpy_scalar(alpha, x.data(), y.data(), y.size());
+}
+
+inline void axpy_avx(double alpha, const memory::AlignedBuffer<double>& x, memory::AlignedBuffer<double>& y)
+{
+    axpy_avx(alpha, x.data(), y.data(), y.size());
+}
+
+} // namespace kitpp::math
+
+#endif // KITPP_DAXPY_HPP
@@ -0,0 +1,100 @@
+#ifndef KITPP_MATH_DISPATCH_HPP
+#define KITPP_MATH_DISPATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../memory/aligned_buffer.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #define KITPP_MATH_X86 1
+#endif
+
+namespace kitpp::math {
+
+// --- Runtime Kernel Dispatch ---
+// dot() and axpy() pick the widest kernel the running CPU supports
+// (cpuid, including OS support for the AVX register state) on their first
+// call and cache it in a function pointer, so the library is built without
+// -march and still uses AVX2/AVX-512 where available. The variants live in
+// src/math/kernels_*.cpp, each compiled with per-function target
+// attributes. KITPP_MATH_ISA=scalar|avx2|avx512 in the environment caps
+// the choice (an unsupported request falls back to the best available).
+// Unlike dot_avx_* in dot_prod.hpp, these kernels accept unaligned data.
+
+enum class Isa { Scalar, Avx2, Avx512 };
+
+inline const char* isa_name(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar:
+        return "scalar";
+    case Isa::Avx2:
+        return "avx2";
+    case Isa::Avx512:
+        return "avx512";
+    }
+    return "?";
+}
+
+// Best variant this CPU supports, ignoring KITPP_MATH_ISA
+Isa detect_isa();
+
+// Variant dot()/axpy() use (resolves it on first call)
+Isa active_isa();
+
+// Switches every kernel to 'isa' (e.g. to benchmark the variants against
+// each other); false and no change if the CPU does not support it
+bool set_isa(Isa isa);
+
+// sum of a[i] * b[i] for i < n
+double dot(const double* a, const double* b, std::size_t n);
+
+// y[i] += alpha * x[i] for i < n (OpenMP parallel when enabled)
+void axpy(double alpha, const double* x, double* y, std::size_t n);
+
+namespace detail {
+
+    using DotFn = double (*)(const double*, const double*, std::size_t);
+    using AxpyFn = void (*)(double, const double*, double*, std::size_t);
+
+    double dot_scalar(const double* a, const double* b, std::size_t n);
+    void axpy_scalar(double alpha, const double* x, double* y, std::size_t n);
+
+#if defined(KITPP_MATH_X86)
+    double dot_avx2(const double* a, const double* b, std::size_t n);
+    void axpy_avx2(double alpha, const double* x, double* y, std::size_t n);
+    double dot_avx512(const double* a, const double* b, std::size_t n);
+    void axpy_avx512(double alpha, const double* x, double* y, std::size_t n);
+#endif
+
+} // namespace detail
+
+// --- Container overloads ---
+// dot uses the first min(a.size(), b.size()) elements; axpy uses
+// y.size() elements and x must hold at least as many
+
+inline double dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return dot(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+inline double dot(const memory::AlignedBuffer<double>& a, const memory::AlignedBuffer<double>& b)
+{
+    return dot(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+inline void axpy(double alpha, const std::vector<double>& x, std::vector<double>& y)
+{
+    axpy(alpha, x.data(), y.data(), y.size());
+}
+
+inline void axpy(double alpha, const memory::AlignedBuffer<double>& x, memory::AlignedBuffer<double>& y)
+{
+    axpy(alpha, x.data(), y.data(), y.size());
+}
+
+} // namespace kitpp::math
+
+#endif // KITPP_MATH_DISPATCH_HPP
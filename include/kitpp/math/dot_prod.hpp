@@ -1,3 +1,7 @@
+#ifndef KITPP_DOT_PROD_HPP
+#define KITPP_DOT_PROD_HPP
+
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstring>
@@ -7,6 +11,9 @@
 #include <numeric>
 #include <vector>
 
+#include "../memory/aligned_buffer.hpp"
+#include "../sys/platform.hpp" // KITPP_TARGET
+
 namespace kitpp::math {
 
 /**
@@ -28,7 +35,7 @@ namespace kitpp::math {
  *
  * @note This version is portable and serves as a correctness/reference baseline.
  */
-double dot_scalar(const double* __restrict__ a, const double* __restrict__ b, size_t n)
+inline double dot_scalar(const double* __restrict__ a, const double* __restrict__ b, size_t n)
 {
     double sum = 0.0;
     for (size_t i = 0; i < n; ++i) {
@@ -50,7 +57,8 @@ double dot_scalar(const double* __restrict__ a, const double* __restrict__ b, si
  *
  * @return Dot product of @p a and @p b over @p n elements.
  *
- * @pre CPU supports AVX2 and FMA (e.g., compile with `-mavx2 -mfma` or appropriate target flags).
+ * @pre CPU supports AVX2 and FMA. The function is compiled for them by its own target attribute,
+ *      so check first (kitpp::math::detect_isa()) or call kitpp::math::dot(), which dispatches.
  * @pre @p a and @p b point to valid memory containing at least @p n doubles.
  * @pre Loads use `_mm256_load_pd`, so @p a and @p b must be 32-byte aligned for the vectorized
  *      iterations (or replace loads with `_mm256_loadu_pd` if alignment cannot be guaranteed).
@@ -59,7 +67,7 @@ double dot_scalar(const double* __restrict__ a, const double* __restrict__ b, si
  * @note Numerical results may differ slightly from the scalar implementation due to
  *       different summation order (floating-point non-associativity).
  */
-double dot_avx_4x(const double* __restrict__ a, const double* __restrict__ b, size_t n)
+KITPP_TARGET("avx2,fma") inline double dot_avx_4x(const double* __restrict__ a, const double* __restrict__ b, size_t n)
 {
     size_t i = 0;
 
@@ -104,7 +112,8 @@ double dot_avx_4x(const double* __restrict__ a, const double* __restrict__ b, si
  *
  * @return Dot product of @p a and @p b over @p n elements.
  *
- * @pre CPU supports AVX2 and FMA (e.g., compile with `-mavx2 -mfma` or appropriate target flags).
+ * @pre CPU supports AVX2 and FMA. The function is compiled for them by its own target attribute,
+ *      so check first (kitpp::math::detect_isa()) or call kitpp::math::dot(), which dispatches.
  * @pre @p a and @p b point to valid memory containing at least @p n doubles.
  * @pre Loads use `_mm256_load_pd`, so @p a and @p b must be 32-byte aligned for the vectorized
  *      iterations (or replace loads with `_mm256_loadu_pd` if alignment cannot be guaranteed).
@@ -113,7 +122,7 @@ double dot_avx_4x(const double* __restrict__ a, const double* __restrict__ b, si
  * @note Numerical results may differ slightly from the scalar implementation due to
  *       different summation order (floating-point non-associativity).
  */
-double dot_avx_zen2(const double* __restrict__ a, const double* __restrict__ b, size_t n)
+KITPP_TARGET("avx2,fma") inline double dot_avx_zen2(const double* __restrict__ a, const double* __restrict__ b, size_t n)
 {
     size_t i = 0;
 
@@ -164,4 +173,26 @@ double dot_avx_zen2(const double* __restrict__ a, const double* __restrict__ b,
 
     return final_sum;
 }
+
+// --- AlignedBuffer overloads ---
+// AlignedBuffer storage is 64-byte aligned, which satisfies the aligned
+// loads of the AVX kernels. Uses the first min(a.size(), b.size()) elements.
+
+inline double dot_scalar(const memory::AlignedBuffer<double>& a, const memory::AlignedBuffer<double>& b)
+{
+    return dot_scalar(a.data(), b.data(), std::min(a.size(), b.size()));
 }
+
+inline double dot_avx_4x(const memory::AlignedBuffer<double>& a, const memory::AlignedBuffer<double>& b)
+{
+    return dot_avx_4x(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+inline double dot_avx_zen2(const memory::AlignedBuffer<double>& a, const memory::AlignedBuffer<double>& b)
+{
+    return dot_avx_zen2(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+} // namespace kitpp::math
+
+#endif // KITPP_DOT_PROD_HPP
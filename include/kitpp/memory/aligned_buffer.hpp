@@ -0,0 +1,180 @@
+#ifndef KITPP_ALIGNED_BUFFER_HPP
+#define KITPP_ALIGNED_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../sys/platform.hpp" // For OpenMP checks/includes
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+#endif
+
+namespace kitpp::memory {
+
+// --- Aligned Memory ---
+// aligned_allocator<T, Align> for std containers, and AlignedBuffer<T>, a
+// fixed-size array for numeric kernels: 64-byte aligned (a cache line,
+// enough for AVX-512 aligned loads), optionally backed by 2 MiB
+// transparent huge pages, and initialized by a parallel first touch so
+// each page lands on the NUMA node of the OpenMP thread that later works
+// on that part of the array (same static schedule as the kernels).
+
+constexpr std::size_t cache_line_size = 64;
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+template <typename T, std::size_t Align = cache_line_size>
+class aligned_allocator {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Align must be a power of two >= alignof(T)");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Align>;
+    };
+
+    aligned_allocator() noexcept = default;
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    template <typename U>
+    bool operator==(const aligned_allocator<U, Align>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const aligned_allocator<U, Align>&) const noexcept { return false; }
+};
+
+struct BufferOptions {
+    bool huge_pages = false;          // 2 MiB alignment + madvise(MADV_HUGEPAGE) (Linux)
+    bool parallel_first_touch = true; // Initialize with "omp parallel for schedule(static)"
+};
+
+template <typename T>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+        "AlignedBuffer holds plain numeric data");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    AlignedBuffer() = default;
+
+    explicit AlignedBuffer(std::size_t n, const T& value = T {}, BufferOptions options = {})
+        : size_(n)
+    {
+        if (n == 0) {
+            return;
+        }
+        // Leaves room for rounding up to the largest alignment below
+        if (n > (std::numeric_limits<std::size_t>::max() - huge_page_size) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        const std::size_t bytes = n * sizeof(T);
+        std::size_t align = cache_line_size;
+        if (options.huge_pages && bytes >= huge_page_size) {
+            align = huge_page_size;
+        }
+        // aligned_alloc wants a multiple of the alignment
+        const std::size_t rounded = (bytes + align - 1) / align * align;
+        data_ = static_cast<T*>(std::aligned_alloc(align, rounded));
+        if (data_ == nullptr) {
+            throw std::bad_alloc();
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (align == huge_page_size) {
+            huge_pages_ = ::madvise(data_, rounded, MADV_HUGEPAGE) == 0;
+        }
+#endif
+        if (options.parallel_first_touch) {
+            fill(value);
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                data_[i] = value;
+            }
+        }
+    }
+
+    ~AlignedBuffer() { std::free(data_); }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , huge_pages_(std::exchange(other.huge_pages_, false))
+    {
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            std::free(data_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            huge_pages_ = std::exchange(other.huge_pages_, false);
+        }
+        return *this;
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    // Parallel, statically scheduled write of every element
+    void fill(const T& value)
+    {
+        T* data = data_;
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(size_);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+            data[i] = value;
+        }
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // madvise(MADV_HUGEPAGE) was applied (the kernel may still use 4 KiB pages)
+    bool huge_pages() const noexcept { return huge_pages_; }
+
+    T& operator[](std::size_t i) noexcept { return data_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool huge_pages_ = false;
+};
+
+} // namespace kitpp::memory
+
+#endif // KITPP_ALIGNED_BUFFER_HPP
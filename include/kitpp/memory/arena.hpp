@@ -0,0 +1,173 @@
+#ifndef KITPP_ARENA_HPP
+#define KITPP_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kitpp::memory {
+
+// --- Arena (monotonic bump allocator) ---
+// allocate() bumps a pointer inside the current chunk; when it does not
+// fit, the next chunk is used (doubling in size up to max_chunk, larger
+// requests get a chunk of their own). Nothing is freed individually.
+// reset() rewinds to the first chunk and keeps every chunk for reuse, so a
+// per-request arena stops calling malloc after the first few requests;
+// release() returns the memory. Not thread-safe: one arena per thread or
+// per request.
+class Arena {
+public:
+    explicit Arena(std::size_t initial_chunk = 64 * 1024, std::size_t max_chunk = 64 * 1024 * 1024)
+        : next_size_(std::max<std::size_t>(initial_chunk, 256))
+        , max_chunk_(std::max(max_chunk, next_size_))
+    {
+    }
+
+    ~Arena() { release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+    {
+        std::uintptr_t p = align_up(cur_, align);
+        if (p + bytes > end_ || cur_ == 0) {
+            p = next_chunk(bytes, align);
+        }
+        cur_ = p + bytes;
+        used_ += bytes;
+        return reinterpret_cast<void*>(p);
+    }
+
+    // Constructs a T in the arena; its destructor is never run
+    template <typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena does not run destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Uninitialized array of n T
+    template <typename T>
+    T* allocate_array(std::size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena does not run destructors");
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // Invalidates everything allocated; keeps the chunks
+    void reset() noexcept
+    {
+        index_ = 0;
+        cur_ = end_ = 0;
+        used_ = 0;
+        if (!chunks_.empty()) {
+            enter(0);
+        }
+    }
+
+    // Frees every chunk
+    void release() noexcept
+    {
+        for (auto& c : chunks_) {
+            std::free(c.data);
+        }
+        chunks_.clear();
+        index_ = 0;
+        cur_ = end_ = 0;
+        used_ = 0;
+    }
+
+    // Bytes handed out since the last reset (without alignment padding)
+    std::size_t bytes_used() const noexcept { return used_; }
+
+    // Bytes held in chunks
+    std::size_t bytes_reserved() const noexcept
+    {
+        std::size_t total = 0;
+        for (const auto& c : chunks_) {
+            total += c.size;
+        }
+        return total;
+    }
+
+    std::size_t chunk_count() const noexcept { return chunks_.size(); }
+
+private:
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    void enter(std::size_t i) noexcept
+    {
+        index_ = i;
+        cur_ = reinterpret_cast<std::uintptr_t>(chunks_[i].data);
+        end_ = cur_ + chunks_[i].size;
+    }
+
+    static std::uintptr_t align_up(std::uintptr_t p, std::size_t align) noexcept
+    {
+        return (p + align - 1) & ~(std::uintptr_t(align) - 1);
+    }
+
+    // Moves to the first later chunk that fits, else inserts a new one
+    // after the current chunk (smaller leftovers are skipped until reset)
+    std::uintptr_t next_chunk(std::size_t bytes, std::size_t align)
+    {
+        const std::size_t need = bytes + align;
+        const std::size_t first = chunks_.empty() ? 0 : index_ + 1;
+        for (std::size_t i = first; i < chunks_.size(); ++i) {
+            if (chunks_[i].size >= need) {
+                enter(i);
+                return align_up(cur_, align);
+            }
+        }
+        const std::size_t size = std::max(next_size_, need);
+        char* data = static_cast<char*>(std::malloc(size));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        next_size_ = std::min(next_size_ * 2, max_chunk_);
+        chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(first), Chunk { data, size });
+        enter(first);
+        return align_up(cur_, align);
+    }
+
+    std::vector<Chunk> chunks_;
+    std::size_t index_ = 0; // Chunk cur_ points into
+    std::uintptr_t cur_ = 0;
+    std::uintptr_t end_ = 0;
+    std::size_t used_ = 0;
+    std::size_t next_size_;
+    std::size_t max_chunk_;
+};
+
+// std::pmr adapter: pmr containers allocate from the arena, deallocation
+// is a no-op (memory comes back with Arena::reset / release)
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(Arena& arena) noexcept
+        : arena_(arena)
+    {
+    }
+
+    Arena& arena() noexcept { return arena_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override { return arena_.allocate(bytes, align); }
+    void do_deallocate(void*, std::size_t, std::size_t) override { }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Arena& arena_;
+};
+
+} // namespace kitpp::memory
+
+#endif // KITPP_ARENA_HPP
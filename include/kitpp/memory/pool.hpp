@@ -0,0 +1,175 @@
+#ifndef KITPP_POOL_HPP
+#define KITPP_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace kitpp::memory {
+
+// --- FixedPool (fixed-size blocks) ---
+// Blocks of one size come from slabs of 'blocks_per_slab' blocks; freed
+// blocks go onto an intrusive free list and are handed out again first.
+// allocate / deallocate are a pointer pop / push. Slabs are returned only
+// when the pool is destroyed. Not thread-safe: use ObjectPool<T>::local()
+// for a pool per thread.
+class FixedPool {
+public:
+    explicit FixedPool(std::size_t block_size, std::size_t block_align = alignof(std::max_align_t),
+        std::size_t blocks_per_slab = 256)
+        : align_(std::max(block_align, alignof(void*)))
+        , block_size_((std::max(block_size, sizeof(void*)) + align_ - 1) / align_ * align_)
+        , per_slab_(std::max<std::size_t>(blocks_per_slab, 1))
+    {
+    }
+
+    ~FixedPool()
+    {
+        for (void* slab : slabs_) {
+            ::operator delete(slab, std::align_val_t(align_));
+        }
+    }
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    void* allocate()
+    {
+        if (free_ == nullptr) {
+            grow();
+        }
+        Node* n = free_;
+        free_ = n->next;
+        ++live_;
+        return n;
+    }
+
+    void deallocate(void* p) noexcept
+    {
+        Node* n = static_cast<Node*>(p);
+        n->next = free_;
+        free_ = n;
+        --live_;
+    }
+
+    std::size_t block_size() const noexcept { return block_size_; }
+    std::size_t block_align() const noexcept { return align_; }
+    std::size_t live_blocks() const noexcept { return live_; }
+    std::size_t slab_count() const noexcept { return slabs_.size(); }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    void grow()
+    {
+        char* slab = static_cast<char*>(::operator new(block_size_ * per_slab_, std::align_val_t(align_)));
+        slabs_.push_back(slab);
+        // Thread the new blocks in address order
+        for (std::size_t i = per_slab_; i-- > 0;) {
+            Node* n = reinterpret_cast<Node*>(slab + i * block_size_);
+            n->next = free_;
+            free_ = n;
+        }
+    }
+
+    std::size_t align_;
+    std::size_t block_size_;
+    std::size_t per_slab_;
+    Node* free_ = nullptr;
+    std::size_t live_ = 0;
+    std::vector<void*> slabs_;
+};
+
+// --- ObjectPool<T> ---
+// Typed FixedPool: create() constructs a T in a pooled block, destroy()
+// runs its destructor and returns the block. local() is this thread's
+// pool (no locking); objects from it must be destroyed on the same thread.
+template <typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(std::size_t objects_per_slab = 256)
+        : pool_(sizeof(T), alignof(T), objects_per_slab)
+    {
+    }
+
+    static ObjectPool& local()
+    {
+        thread_local ObjectPool pool;
+        return pool;
+    }
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        void* p = pool_.allocate();
+        try {
+            return new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_.deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T* obj) noexcept
+    {
+        if (obj != nullptr) {
+            obj->~T();
+            pool_.deallocate(obj);
+        }
+    }
+
+    std::size_t live_objects() const noexcept { return pool_.live_blocks(); }
+
+private:
+    FixedPool pool_;
+};
+
+// std::pmr adapter: requests that fit the block size and alignment come
+// from the pool, anything else goes to the upstream resource. Like the
+// pool it is not thread-safe.
+class PoolResource : public std::pmr::memory_resource {
+public:
+    explicit PoolResource(std::size_t block_size, std::size_t blocks_per_slab = 256,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : pool_(block_size, alignof(std::max_align_t), blocks_per_slab)
+        , upstream_(upstream)
+    {
+    }
+
+    FixedPool& pool() noexcept { return pool_; }
+
+private:
+    bool pooled(std::size_t bytes, std::size_t align) const noexcept
+    {
+        return bytes <= pool_.block_size() && align <= pool_.block_align();
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        return pooled(bytes, align) ? pool_.allocate() : upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+        if (pooled(bytes, align)) {
+            pool_.deallocate(p);
+        } else {
+            upstream_->deallocate(p, bytes, align);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    FixedPool pool_;
+    std::pmr::memory_resource* upstream_;
+};
+
+} // namespace kitpp::memory
+
+#endif // KITPP_POOL_HPP
@@ -0,0 +1,183 @@
+#ifndef KITPP_CLOCK_HPP
+#define KITPP_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  #define KITPP_HAS_TSC 1
+  #include <cpuid.h>
+  #include <x86intrin.h>
+#else
+  #define KITPP_HAS_TSC 0
+#endif
+
+namespace kitpp::clocks {
+
+// --- Clock Policies ---
+// Every timer takes one of these as a template parameter. A policy has a
+// cheap now() returning an opaque tick, and to_ns() converting a tick
+// difference to nanoseconds.
+
+// std::chrono::steady_clock (clock_gettime, ~20 ns per read)
+struct SteadyClock {
+    using tick = std::int64_t;
+    static constexpr std::string_view name = "steady";
+
+    static tick now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static std::int64_t to_ns(tick delta) noexcept { return delta; }
+};
+
+// omp_get_wtime(); steady_clock when built without OpenMP
+struct OmpClock {
+#if defined(_OPENMP)
+    using tick = double;
+    static constexpr std::string_view name = "omp_get_wtime";
+
+    static tick now() noexcept { return ::omp_get_wtime(); }
+    static std::int64_t to_ns(tick delta) noexcept { return static_cast<std::int64_t>(delta * 1e9); }
+#else
+    using tick = SteadyClock::tick;
+    static constexpr std::string_view name = "steady";
+
+    static tick now() noexcept { return SteadyClock::now(); }
+    static std::int64_t to_ns(tick delta) noexcept { return delta; }
+#endif
+};
+
+namespace detail {
+
+    // Result of the one-time TSC check and calibration
+    struct TscInfo {
+        bool reliable = false; // Invariant TSC present and calibration sane
+        bool has_rdtscp = false;
+        double ns_per_tick = 1.0;
+        double ghz = 0.0;
+    };
+
+#if KITPP_HAS_TSC
+    inline std::uint64_t read_tsc(bool rdtscp) noexcept
+    {
+        if (rdtscp) {
+            unsigned aux;
+            return __rdtscp(&aux); // Waits for earlier instructions to retire
+        }
+        _mm_lfence();
+        return __rdtsc();
+    }
+
+    // Measures the TSC rate against steady_clock over ~10 ms
+    inline TscInfo calibrate_tsc()
+    {
+        TscInfo info;
+        const char* env = std::getenv("KITPP_CLOCK");
+        if (env != nullptr && std::string_view(env) == "steady") {
+            return info; // Forced fallback
+        }
+
+        unsigned eax, ebx, ecx, edx;
+        if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+            return info;
+        }
+        __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx);
+        info.has_rdtscp = (edx & (1u << 27)) != 0;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        const bool invariant = (edx & (1u << 8)) != 0;
+        if (!invariant) {
+            return info; // Rate may change with P-states or stop in C-states
+        }
+
+        using std::chrono::steady_clock;
+        auto t0 = steady_clock::now();
+        std::uint64_t c0 = read_tsc(info.has_rdtscp);
+        auto deadline = t0 + std::chrono::milliseconds(10);
+        while (steady_clock::now() < deadline) {
+        }
+        std::uint64_t c1 = read_tsc(info.has_rdtscp);
+        auto t1 = steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        double ticks = static_cast<double>(c1 - c0);
+        if (c1 <= c0 || ns <= 0.0) {
+            return info;
+        }
+        info.ghz = ticks / ns;
+        if (info.ghz < 0.1 || info.ghz > 10.0) {
+            return info; // Implausible rate (e.g. a VM scaling the TSC badly)
+        }
+        info.ns_per_tick = ns / ticks;
+        info.reliable = true;
+        return info;
+    }
+#else
+    inline TscInfo calibrate_tsc()
+    {
+        return {};
+    }
+#endif
+
+    inline const TscInfo& tsc_info()
+    {
+        static const TscInfo info = calibrate_tsc();
+        return info;
+    }
+
+} // namespace detail
+
+// rdtscp-based clock calibrated against steady_clock at first use.
+// Falls back to SteadyClock (ticks are then nanoseconds) when the CPU has
+// no invariant TSC, calibration looks wrong, or KITPP_CLOCK=steady.
+struct TscClock {
+    using tick = std::uint64_t;
+    static constexpr std::string_view name = "tsc";
+
+    static tick now() noexcept
+    {
+#if KITPP_HAS_TSC
+        const detail::TscInfo& info = detail::tsc_info();
+        if (info.reliable) {
+            return detail::read_tsc(info.has_rdtscp);
+        }
+#endif
+        return static_cast<tick>(SteadyClock::now());
+    }
+
+    static std::int64_t to_ns(tick delta) noexcept
+    {
+        const detail::TscInfo& info = detail::tsc_info();
+        if (info.reliable) {
+            return static_cast<std::int64_t>(static_cast<double>(delta) * info.ns_per_tick);
+        }
+        return static_cast<std::int64_t>(delta);
+    }
+
+    // True if now() really reads the TSC
+    static bool reliable() noexcept { return detail::tsc_info().reliable; }
+};
+
+} // namespace kitpp::clocks
+
+// Clock used by ScopeTimer, ManualTimer and ThroughputLogger unless a
+// timer names one explicitly. Override with e.g.
+// -DKITPP_TIMER_CLOCK=kitpp::clocks::SteadyClock
+#ifndef KITPP_TIMER_CLOCK
+#define KITPP_TIMER_CLOCK kitpp::clocks::TscClock
+#endif
+
+namespace kitpp::clocks {
+using DefaultClock = KITPP_TIMER_CLOCK;
+} // namespace kitpp::clocks
+
+#endif // KITPP_CLOCK_HPP
@@ -0,0 +1,257 @@
+#ifndef KITPP_PERF_EVENTS_HPP
+#define KITPP_PERF_EVENTS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #define KITPP_HAS_PERF_EVENTS 1
+#else
+  #define KITPP_HAS_PERF_EVENTS 0
+#endif
+
+namespace kitpp::perf {
+
+// --- Hardware / Software Counters (Linux perf_event_open) ---
+// Counters are opened once per thread and event set, as one group so they
+// are scheduled (and multiplexed) together, and count user space of the
+// calling thread only. They keep running; a scope reads them at entry and
+// exit and reports the difference.
+
+enum class Event : std::uint8_t {
+    Cycles,
+    Instructions,
+    LlcMisses,       // Generic "cache-misses" (last-level cache on most CPUs)
+    BranchMisses,
+    TaskClock,       // Software: ns the thread was on a CPU
+    PageFaults,      // Software
+    ContextSwitches, // Software
+    CpuMigrations,   // Software
+};
+
+constexpr int event_count = 8;
+
+using EventMask = std::uint32_t;
+
+constexpr EventMask bit(Event e)
+{
+    return EventMask(1) << static_cast<int>(e);
+}
+
+constexpr EventMask default_events = bit(Event::Cycles) | bit(Event::Instructions)
+    | bit(Event::LlcMisses) | bit(Event::BranchMisses) | bit(Event::TaskClock);
+
+// Opened instead when none of the requested hardware events are available
+// (containers, most VMs, perf_event_paranoid > 2)
+constexpr EventMask software_fallback = bit(Event::TaskClock) | bit(Event::PageFaults)
+    | bit(Event::ContextSwitches);
+
+constexpr EventMask hardware_events = bit(Event::Cycles) | bit(Event::Instructions)
+    | bit(Event::LlcMisses) | bit(Event::BranchMisses);
+
+inline EventMask mask_of(std::initializer_list<Event> events)
+{
+    EventMask mask = 0;
+    for (Event e : events) {
+        mask |= bit(e);
+    }
+    return mask == 0 ? default_events : mask;
+}
+
+inline std::string_view event_name(Event e)
+{
+    switch (e) {
+    case Event::Cycles: return "cycles";
+    case Event::Instructions: return "instructions";
+    case Event::LlcMisses: return "llc_misses";
+    case Event::BranchMisses: return "branch_misses";
+    case Event::TaskClock: return "task_clock_ns";
+    case Event::PageFaults: return "page_faults";
+    case Event::ContextSwitches: return "context_switches";
+    case Event::CpuMigrations: return "cpu_migrations";
+    }
+    return "?";
+}
+
+// Raw group read: time the group was enabled / actually counting, plus
+// one value per event (indexed by Event)
+struct Reading {
+    std::uint64_t time_enabled = 0;
+    std::uint64_t time_running = 0;
+    std::uint64_t values[event_count] = {};
+};
+
+// Counter differences between two readings, scaled up if the group was
+// multiplexed for part of the interval
+struct Counts {
+    EventMask valid = 0;
+    double values[event_count] = {};
+    double running_fraction = 1.0; // < 1 when multiplexed
+
+    bool has(Event e) const { return (valid & bit(e)) != 0; }
+    double operator[](Event e) const { return values[static_cast<int>(e)]; }
+};
+
+class CounterGroup {
+public:
+    explicit CounterGroup(EventMask requested)
+        : requested_(requested)
+    {
+        for (int& fd : fds_) {
+            fd = -1;
+        }
+        // Hardware first so the leader is a hardware event when possible
+        open_mask(requested & hardware_events);
+        open_mask(requested & ~hardware_events);
+        if ((requested & hardware_events) != 0 && (opened_ & hardware_events) == 0) {
+            fell_back_ = true;
+            open_mask(software_fallback & ~opened_);
+        }
+    }
+
+    ~CounterGroup()
+    {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+#if KITPP_HAS_PERF_EVENTS
+                ::close(fd);
+#endif
+            }
+        }
+    }
+
+    CounterGroup(const CounterGroup&) = delete;
+    CounterGroup& operator=(const CounterGroup&) = delete;
+
+    EventMask requested() const { return requested_; }
+    EventMask opened() const { return opened_; }
+    bool fell_back() const { return fell_back_; }
+
+    bool read(Reading& out) const
+    {
+#if KITPP_HAS_PERF_EVENTS
+        if (leader_ < 0) {
+            return false;
+        }
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+        std::uint64_t buf[3 + event_count];
+        ssize_t n = ::read(leader_, buf, sizeof(buf));
+        if (n < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) {
+            return false;
+        }
+        out.time_enabled = buf[1];
+        out.time_running = buf[2];
+        for (int e = 0; e < event_count; ++e) {
+            if (slot_[e] >= 0 && static_cast<std::uint64_t>(slot_[e]) < buf[0]) {
+                out.values[e] = buf[3 + slot_[e]];
+            }
+        }
+        return true;
+#else
+        (void)out;
+        return false;
+#endif
+    }
+
+    Counts delta(const Reading& begin, const Reading& end) const
+    {
+        Counts c;
+        c.valid = opened_;
+        const double enabled = static_cast<double>(end.time_enabled - begin.time_enabled);
+        const double running = static_cast<double>(end.time_running - begin.time_running);
+        double scale = 1.0;
+        if (running <= 0.0) {
+            c.valid = 0; // Group never got a counter slot
+            return c;
+        }
+        if (running < enabled) {
+            scale = enabled / running;
+            c.running_fraction = running / enabled;
+        }
+        for (int e = 0; e < event_count; ++e) {
+            if (opened_ & (EventMask(1) << e)) {
+                c.values[e] = static_cast<double>(end.values[e] - begin.values[e]) * scale;
+            }
+        }
+        return c;
+    }
+
+private:
+    void open_mask(EventMask mask)
+    {
+        for (int e = 0; e < event_count; ++e) {
+            if (mask & (EventMask(1) << e)) {
+                open_one(static_cast<Event>(e));
+            }
+        }
+    }
+
+    void open_one(Event e)
+    {
+#if KITPP_HAS_PERF_EVENTS
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.exclude_kernel = 1; // Allowed at perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (e) {
+        case Event::Cycles: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case Event::Instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case Event::LlcMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case Event::BranchMisses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case Event::TaskClock: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_TASK_CLOCK; break;
+        case Event::PageFaults: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_PAGE_FAULTS; break;
+        case Event::ContextSwitches: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES; break;
+        case Event::CpuMigrations: attr.type = PERF_TYPE_SOFTWARE; attr.config = PERF_COUNT_SW_CPU_MIGRATIONS; break;
+        }
+        long fd = ::syscall(SYS_perf_event_open, &attr, 0 /* this thread */, -1 /* any cpu */,
+            leader_, PERF_FLAG_FD_CLOEXEC);
+        if (fd < 0) {
+            return; // Not supported or not permitted: event stays unavailable
+        }
+        const int idx = static_cast<int>(e);
+        fds_[idx] = static_cast<int>(fd);
+        slot_[idx] = members_++;
+        if (leader_ < 0) {
+            leader_ = static_cast<int>(fd);
+        }
+        opened_ |= bit(e);
+#else
+        (void)e;
+#endif
+    }
+
+    EventMask requested_;
+    EventMask opened_ = 0;
+    bool fell_back_ = false;
+    int leader_ = -1;
+    int members_ = 0;
+    int fds_[event_count];
+    int slot_[event_count] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+};
+
+// The calling thread's group for an event set, opened on first use
+inline CounterGroup& thread_group(EventMask requested)
+{
+    thread_local std::vector<std::unique_ptr<CounterGroup>> groups;
+    for (auto& g : groups) {
+        if (g->requested() == requested) {
+            return *g;
+        }
+    }
+    groups.push_back(std::make_unique<CounterGroup>(requested));
+    return *groups.back();
+}
+
+} // namespace kitpp::perf
+
+#endif // KITPP_PERF_EVENTS_HPP
@@ -11,10 +11,27 @@
   #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+  #include <sys/syscall.h>
+#endif
+
 #if defined(_OPENMP)
   #include <omp.h>
 #endif
 
+// Token pasting that expands its arguments first (e.g. __LINE__)
+#define KITPP_CONCAT_IMPL(a, b) a##b
+#define KITPP_CONCAT(a, b) KITPP_CONCAT_IMPL(a, b)
+
+// Compiles one function for an instruction set the build flags do not
+// enable, e.g. KITPP_TARGET("avx2,fma"). Callers must check the CPU first
+// (math/dispatch.hpp does).
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define KITPP_TARGET(isa) __attribute__((target(isa)))
+#else
+  #define KITPP_TARGET(isa)
+#endif
+
 namespace kitpp {
 
     // PID
@@ -26,11 +43,26 @@ namespace kitpp {
 #endif
     }
 
-    // C++ thread id → string
-    inline std::string tid_string() {
-        std::ostringstream os;
-        os << std::this_thread::get_id();
-        return os.str();
+    // C++ thread id → string (formatted once per thread)
+    inline const std::string& tid_string() {
+        thread_local const std::string id = [] {
+            std::ostringstream os;
+            os << std::this_thread::get_id();
+            return os.str();
+        }();
+        return id;
+    }
+
+    // Kernel thread id, as shown by top/perf (cached per thread)
+    inline long os_tid() {
+#if defined(_WIN32)
+        return static_cast<long>(::GetCurrentThreadId());
+#elif defined(__linux__)
+        thread_local const long id = static_cast<long>(::syscall(SYS_gettid));
+        return id;
+#else
+        return static_cast<long>(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+#endif
     }
 
     // OpenMP helpers (safe when OpenMP absent)
@@ -0,0 +1,349 @@
+#ifndef KITPP_RESOURCE_SAMPLER_HPP
+#define KITPP_RESOURCE_SAMPLER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h> // POSIX specific
+
+#if defined(__linux__)
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include "../log/format.hpp"
+#include "../log/TimerCommon.hpp"
+#include "clock.hpp"
+
+namespace kitpp::resource {
+
+// --- Background Resource Sampler ---
+// An opt-in thread that reads /proc/self/{status,statm,io} and getrusage
+// every 'interval' into a ring buffer allocated up front (the oldest
+// samples are overwritten). The /proc files stay open and are re-read
+// with pread into a stack buffer, so a sample costs a few syscalls and no
+// allocation. Each sample carries a tick of the timers' clock, so memory
+// growth can be lined up with timed phases, and the wall-clock time, which
+// the CSV writes as the same Timestamp column the timer CSVs use (the key
+// to join them on). Values that cannot be read
+// (non-Linux, no /proc/self/io permission) are -1.
+
+struct Sample {
+    std::int64_t wall_ms = 0;     // system_clock, ms since the epoch
+    std::int64_t elapsed_ns = 0;  // Since the sampler was created, timer clock
+    std::int64_t rss_kb = -1;     // VmRSS
+    std::int64_t anon_kb = -1;    // RssAnon
+    std::int64_t file_kb = -1;    // RssFile
+    std::int64_t shmem_kb = -1;   // RssShmem
+    std::int64_t peak_rss_kb = -1; // VmHWM
+    std::int64_t vm_pages = -1;   // statm: total program size
+    std::int64_t shared_pages = -1; // statm: resident file-backed pages
+    std::int64_t minor_faults = 0;
+    std::int64_t major_faults = 0;
+    std::int64_t voluntary_switches = 0;
+    std::int64_t involuntary_switches = 0;
+    std::int64_t user_us = 0;
+    std::int64_t sys_us = 0;
+    std::int64_t read_bytes = -1;  // io: storage reads
+    std::int64_t write_bytes = -1; // io: storage writes
+    std::int64_t rchar = -1;       // io: read() bytes, including cache hits
+    std::int64_t wchar = -1;       // io: write() bytes
+};
+
+namespace detail {
+
+    // "Key:   123 kB" -> 123, or -1
+    inline std::int64_t field(std::string_view text, std::string_view key)
+    {
+        for (std::size_t pos = text.find(key); pos != std::string_view::npos; pos = text.find(key, pos + 1)) {
+            if (pos == 0 || text[pos - 1] == '\n') {
+                const char* p = text.data() + pos + key.size();
+                return std::strtoll(p, nullptr, 10);
+            }
+        }
+        return -1;
+    }
+
+    class ProcFile {
+    public:
+        explicit ProcFile(const char* path)
+        {
+#if defined(__linux__)
+            fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+#else
+            (void)path;
+#endif
+        }
+        ~ProcFile()
+        {
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+#endif
+        }
+        ProcFile(const ProcFile&) = delete;
+        ProcFile& operator=(const ProcFile&) = delete;
+
+        // Whole file into buf (NUL-terminated); empty if unavailable
+        std::string_view read(char* buf, std::size_t size) const
+        {
+#if defined(__linux__)
+            if (fd_ >= 0) {
+                const ssize_t n = ::pread(fd_, buf, size - 1, 0);
+                if (n > 0) {
+                    buf[n] = '\0';
+                    return std::string_view(buf, static_cast<std::size_t>(n));
+                }
+            }
+#else
+            (void)buf;
+            (void)size;
+#endif
+            return {};
+        }
+
+    private:
+        int fd_ = -1;
+    };
+
+} // namespace detail
+
+template <typename Clock = clocks::DefaultClock>
+class BasicResourceSampler {
+public:
+    explicit BasicResourceSampler(std::size_t capacity = 4096)
+        : ring_(capacity > 0 ? capacity : 1)
+        , start_tick_(Clock::now())
+    {
+    }
+
+    ~BasicResourceSampler()
+    {
+        stop();
+    }
+
+    BasicResourceSampler(const BasicResourceSampler&) = delete;
+    BasicResourceSampler& operator=(const BasicResourceSampler&) = delete;
+
+    // Reads every source once (the sampler thread calls this)
+    Sample read_now() const
+    {
+        Sample s;
+        s.elapsed_ns = Clock::to_ns(Clock::now() - start_tick_);
+        s.wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        char buf[4096];
+        std::string_view text = status_.read(buf, sizeof(buf));
+        if (!text.empty()) {
+            s.rss_kb = detail::field(text, "VmRSS:");
+            s.anon_kb = detail::field(text, "RssAnon:");
+            s.file_kb = detail::field(text, "RssFile:");
+            s.shmem_kb = detail::field(text, "RssShmem:");
+            s.peak_rss_kb = detail::field(text, "VmHWM:");
+        }
+        text = statm_.read(buf, sizeof(buf));
+        if (!text.empty()) {
+            char* p = buf;
+            s.vm_pages = std::strtoll(p, &p, 10);
+            std::strtoll(p, &p, 10); // resident: VmRSS above
+            s.shared_pages = std::strtoll(p, &p, 10);
+        }
+        text = io_.read(buf, sizeof(buf));
+        if (!text.empty()) {
+            s.rchar = detail::field(text, "rchar:");
+            s.wchar = detail::field(text, "wchar:");
+            s.read_bytes = detail::field(text, "read_bytes:");
+            s.write_bytes = detail::field(text, "write_bytes:");
+        }
+
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            s.minor_faults = usage.ru_minflt;
+            s.major_faults = usage.ru_majflt;
+            s.voluntary_switches = usage.ru_nvcsw;
+            s.involuntary_switches = usage.ru_nivcsw;
+            s.user_us = static_cast<std::int64_t>(usage.ru_utime.tv_sec) * 1000000 + usage.ru_utime.tv_usec;
+            s.sys_us = static_cast<std::int64_t>(usage.ru_stime.tv_sec) * 1000000 + usage.ru_stime.tv_usec;
+            if (s.peak_rss_kb < 0) {
+                s.peak_rss_kb = usage.ru_maxrss;
+            }
+        }
+        return s;
+    }
+
+    // Takes one sample now and stores it
+    void sample()
+    {
+        const Sample s = read_now();
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        ring_[written_ % ring_.size()] = s;
+        ++written_;
+    }
+
+    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(100))
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        if (thread_.joinable()) {
+            return;
+        }
+        stop_requested_ = false;
+        thread_ = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lk(thread_mutex_);
+            do {
+                lk.unlock();
+                sample();
+                lk.lock();
+            } while (!cv_.wait_for(lk, interval, [this] { return stop_requested_; }));
+        });
+    }
+
+    // Stops the thread after one last sample
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex_);
+            if (!thread_.joinable()) {
+                return;
+            }
+            stop_requested_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        sample();
+    }
+
+    // Stored samples, oldest first
+    std::vector<Sample> samples() const
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        const std::size_t n = written_ < ring_.size() ? written_ : ring_.size();
+        std::vector<Sample> out;
+        out.reserve(n);
+        for (std::size_t i = written_ - n; i < written_; ++i) {
+            out.push_back(ring_[i % ring_.size()]);
+        }
+        return out;
+    }
+
+    // Samples overwritten because the ring was full
+    std::size_t dropped() const
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex_);
+        return written_ > ring_.size() ? written_ - ring_.size() : 0;
+    }
+
+    // Timer-clock tick at which elapsed_ns is 0
+    typename Clock::tick start_tick() const { return start_tick_; }
+
+    void write_csv(std::ostream& os) const
+    {
+        std::string out = "Timestamp,Elapsed_ns,RSS_kB,Anon_kB,File_kB,Shmem_kB,Peak_RSS_kB,VM_Pages,Shared_Pages,"
+                          "Minor_Faults,Major_Faults,Voluntary_CS,Involuntary_CS,User_us,Sys_us,"
+                          "Read_Bytes,Write_Bytes,RChar,WChar\n";
+        for (const Sample& s : samples()) {
+            using kitpp::log::detail::append_value;
+            out += kitpp::detail::time::timestamp_view(s.wall_ms);
+            out += ',';
+            for (std::int64_t v : { s.elapsed_ns, s.rss_kb, s.anon_kb, s.file_kb, s.shmem_kb, s.peak_rss_kb,
+                     s.vm_pages, s.shared_pages, s.minor_faults, s.major_faults, s.voluntary_switches,
+                     s.involuntary_switches, s.user_us, s.sys_us, s.read_bytes, s.write_bytes, s.rchar, s.wchar }) {
+                append_value(out, static_cast<long long>(v), {});
+                out += ',';
+            }
+            out.back() = '\n';
+        }
+        os << out;
+        os.flush();
+    }
+
+    bool write_csv(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        write_csv(out);
+        return static_cast<bool>(out);
+    }
+
+private:
+    detail::ProcFile status_ { "/proc/self/status" };
+    detail::ProcFile statm_ { "/proc/self/statm" };
+    detail::ProcFile io_ { "/proc/self/io" };
+
+    mutable std::mutex ring_mutex_;
+    std::vector<Sample> ring_;
+    std::size_t written_ = 0;
+    typename Clock::tick start_tick_;
+
+    std::mutex thread_mutex_;
+    std::condition_variable cv_;
+    bool stop_requested_ = false;
+    std::thread thread_;
+};
+
+using ResourceSampler = BasicResourceSampler<>;
+
+namespace detail {
+
+    struct GlobalSampler {
+        ResourceSampler sampler { 4096 };
+        std::string path;
+        bool dump_at_exit = false;
+
+        ~GlobalSampler()
+        {
+            sampler.stop();
+            if (dump_at_exit) {
+                sampler.write_csv(path);
+            }
+        }
+    };
+
+    inline GlobalSampler& global_sampler()
+    {
+        static GlobalSampler g;
+        return g;
+    }
+
+} // namespace detail
+
+// The process-wide sampler used by start_sampling()
+inline ResourceSampler& sampler()
+{
+    return detail::global_sampler().sampler;
+}
+
+// Samples every 'interval'; the series is written to 'csv_path' by
+// stop_sampling() or at exit (empty path: keep it in memory only)
+inline void start_sampling(std::chrono::milliseconds interval = std::chrono::milliseconds(100),
+    std::string csv_path = "resource_samples.csv")
+{
+    auto& g = detail::global_sampler();
+    g.path = std::move(csv_path);
+    g.dump_at_exit = !g.path.empty();
+    g.sampler.start(interval);
+}
+
+inline void stop_sampling()
+{
+    auto& g = detail::global_sampler();
+    g.sampler.stop();
+    if (g.dump_at_exit) {
+        g.sampler.write_csv(g.path);
+        g.dump_at_exit = false;
+    }
+}
+
+} // namespace kitpp::resource
+
+#endif // KITPP_RESOURCE_SAMPLER_HPP
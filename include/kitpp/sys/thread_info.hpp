@@ -0,0 +1,221 @@
+#ifndef KITPP_THREAD_INFO_HPP
+#define KITPP_THREAD_INFO_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "platform.hpp" // For OpenMP checks/includes
+
+#if defined(__linux__) && defined(__GLIBC__)
+  #include <pthread.h>
+  #define KITPP_HAS_THREAD_NAMES 1
+#endif
+
+namespace kitpp {
+
+// --- Thread Identity ---
+// Filled in once, the first time a thread asks for it, and read by the
+// loggers and timers afterwards. tid is the kernel thread id that perf,
+// top and /proc show; index is small and dense (the lowest free number,
+// reused after a thread exits), good for arrays of per-thread slots. The
+// name starts as the kernel's name for the thread (the program name for
+// the main thread) and is changed with set_thread_name(), which also
+// renames the thread for top/perf/gdb. Every live thread is listed by
+// live_threads().
+
+struct ThreadInfo {
+    static constexpr std::size_t max_name = 15; // Kernel limit (16 with NUL)
+
+    long tid = 0;
+    unsigned index = 0;
+    int omp_thread = -1; // OpenMP thread number when the block was created
+    char name[max_name + 1] = {};
+
+    std::string_view name_view() const { return std::string_view(name); }
+};
+
+namespace detail {
+
+    class ThreadRegistry {
+    public:
+        static ThreadRegistry& instance()
+        {
+            static ThreadRegistry registry;
+            return registry;
+        }
+
+        void add(ThreadInfo* info)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto free_slot = std::find(used_.begin(), used_.end(), false);
+            info->index = static_cast<unsigned>(free_slot - used_.begin());
+            if (free_slot == used_.end()) {
+                used_.push_back(true);
+            } else {
+                *free_slot = true;
+            }
+            live_.push_back(info);
+        }
+
+        void remove(ThreadInfo* info)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            live_.erase(std::remove(live_.begin(), live_.end(), info), live_.end());
+            used_[info->index] = false;
+        }
+
+        // Under the lock, so snapshots never see half a name
+        void rename(ThreadInfo* info, std::string_view name)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const std::size_t n = std::min(name.size(), ThreadInfo::max_name);
+            std::memcpy(info->name, name.data(), n);
+            info->name[n] = '\0';
+        }
+
+        std::vector<ThreadInfo> snapshot()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<ThreadInfo> out;
+            out.reserve(live_.size());
+            for (const ThreadInfo* info : live_) {
+                out.push_back(*info);
+            }
+            std::sort(out.begin(), out.end(), [](const ThreadInfo& a, const ThreadInfo& b) { return a.index < b.index; });
+            return out;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<ThreadInfo*> live_;
+        std::vector<bool> used_; // Dense indices in use
+    };
+
+    // Copy of the identity kept after ThreadSlot is destroyed, for code that
+    // still logs from later thread_local destructors or exit handlers.
+    // ThreadInfo is trivially destructible, so this stays valid until the
+    // thread is gone. Its index may already be reused by a new thread.
+    struct ExitedThread {
+        bool exited = false;
+        ThreadInfo info;
+    };
+
+    inline ExitedThread& exited_thread()
+    {
+        thread_local ExitedThread e;
+        return e;
+    }
+
+    // Thread-local owner: registers on first use, unregisters at thread exit
+    struct ThreadSlot {
+        ThreadInfo info;
+
+        ThreadSlot()
+        {
+            ThreadRegistry& registry = ThreadRegistry::instance(); // Outlives this slot
+            info.tid = kitpp::os_tid();
+            info.omp_thread = kitpp::omp_tid();
+#if defined(KITPP_HAS_THREAD_NAMES)
+            ::pthread_getname_np(::pthread_self(), info.name, sizeof(info.name));
+#endif
+            registry.add(&info);
+        }
+
+        ~ThreadSlot()
+        {
+            ThreadRegistry::instance().remove(&info);
+            ExitedThread& e = exited_thread();
+            e.info = info;
+            e.exited = true;
+        }
+
+        ThreadSlot(const ThreadSlot&) = delete;
+        ThreadSlot& operator=(const ThreadSlot&) = delete;
+    };
+
+    inline ThreadSlot& thread_slot()
+    {
+        thread_local ThreadSlot slot;
+        return slot;
+    }
+
+} // namespace detail
+
+// This thread's identity block (a copy of it once the thread is exiting)
+inline const ThreadInfo& thread_info()
+{
+    const detail::ExitedThread& e = detail::exited_thread();
+    if (e.exited) {
+        return e.info;
+    }
+    return detail::thread_slot().info;
+}
+
+inline std::string_view thread_name()
+{
+    return thread_info().name_view();
+}
+
+// Names the calling thread (first 15 characters) in kitpp output and, on
+// Linux, for the kernel (top -H, perf, gdb, /proc/<pid>/task/<tid>/comm)
+inline void set_thread_name(std::string_view name)
+{
+    detail::ExitedThread& e = detail::exited_thread();
+    if (e.exited) { // Unregistered: only this thread reads the copy
+        const std::size_t n = std::min(name.size(), ThreadInfo::max_name);
+        std::memcpy(e.info.name, name.data(), n);
+        e.info.name[n] = '\0';
+        return;
+    }
+    ThreadInfo& info = detail::thread_slot().info;
+    detail::ThreadRegistry::instance().rename(&info, name);
+#if defined(KITPP_HAS_THREAD_NAMES)
+    ::pthread_setname_np(::pthread_self(), info.name);
+#endif
+}
+
+// Copies of the blocks of all threads currently alive that have used
+// thread_info() (directly or through the loggers), by index
+inline std::vector<ThreadInfo> live_threads()
+{
+    return detail::ThreadRegistry::instance().snapshot();
+}
+
+// Name of a live thread by kernel tid ("" if unknown)
+inline std::string find_thread_name(long tid)
+{
+    for (const ThreadInfo& t : live_threads()) {
+        if (t.tid == tid) {
+            return std::string(t.name_view());
+        }
+    }
+    return {};
+}
+
+// One line per live thread: index, tid, OpenMP number, name
+inline void print_threads(std::ostream& os)
+{
+    std::string out = "Idx  TID        OMP  Name\n";
+    for (const ThreadInfo& t : live_threads()) {
+        std::string line = std::to_string(t.index);
+        line.resize(5, ' ');
+        line += std::to_string(t.tid);
+        line.resize(16, ' ');
+        line += t.omp_thread >= 0 ? std::to_string(t.omp_thread) : std::string("-");
+        line.resize(21, ' ');
+        line += t.name_view();
+        out += line;
+        out += '\n';
+    }
+    os << out;
+    os.flush();
+}
+
+} // namespace kitpp
+
+#endif // KITPP_THREAD_INFO_HPP
@@ -0,0 +1,462 @@
+#ifndef KITPP_TOPOLOGY_HPP
+#define KITPP_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "platform.hpp" // For OpenMP checks/includes
+
+#if defined(__linux__)
+  #include <dirent.h>
+  #include <sched.h>
+#endif
+
+namespace kitpp::topology {
+
+// --- CPU Topology ---
+// Read once from /sys/devices/system/cpu and /sys/devices/system/node:
+// which logical CPUs are SMT siblings of one physical core, which core
+// sits in which package and NUMA node, and the cache hierarchy with the
+// CPUs sharing each cache. Only online CPUs are listed; 'allowed' marks
+// those in the process-wide affinity mask (Cpus_allowed_list in
+// /proc/self/status: taskset, cgroup cpusets), not the mask of whichever
+// thread happens to call get() first, and placements only use those.
+// Without sysfs (non-Linux) every CPU is its own core in package 0 and
+// no caches are known.
+
+struct Cpu {
+    int id = 0;        // Logical CPU number (as in sched_getcpu)
+    int core = 0;      // Dense physical core index, 0..core_count-1
+    int package = 0;   // physical_package_id
+    int node = 0;      // NUMA node
+    int smt_index = 0; // Position among the core's SMT siblings
+    bool allowed = true;
+};
+
+struct Cache {
+    int level = 0;
+    std::string type;            // "Data", "Instruction" or "Unified"
+    std::size_t size_bytes = 0;
+    std::size_t line_bytes = 0;
+    std::vector<int> shared_cpus; // Logical CPUs sharing this instance
+};
+
+struct Topology {
+    std::vector<Cpu> cpus;      // Sorted by id
+    std::vector<Cache> caches;  // One entry per cache instance
+    int package_count = 1;
+    int core_count = 1;
+    int node_count = 1;
+
+    const Cpu* find(int cpu) const
+    {
+        auto it = std::lower_bound(cpus.begin(), cpus.end(), cpu, [](const Cpu& c, int id) { return c.id < id; });
+        return it != cpus.end() && it->id == cpu ? &*it : nullptr;
+    }
+
+    // Largest number of hardware threads on one core
+    int smt_width() const
+    {
+        int w = 0;
+        for (const auto& c : cpus) {
+            w = std::max(w, c.smt_index + 1);
+        }
+        return w;
+    }
+
+    // Data/unified cache of 'level' serving 'cpu' (nullptr if unknown)
+    const Cache* cache(int level, int cpu = -1) const
+    {
+        if (cpu < 0 && !cpus.empty()) {
+            cpu = cpus.front().id;
+        }
+        for (const auto& c : caches) {
+            if (c.level == level && c.type != "Instruction"
+                && std::find(c.shared_cpus.begin(), c.shared_cpus.end(), cpu) != c.shared_cpus.end()) {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    // Size of one instance of the level-N data/unified cache (0 if unknown),
+    // e.g. to pick a block size: cache_size(2) / cache_sharing(2) per thread
+    std::size_t cache_size(int level) const
+    {
+        const Cache* c = cache(level);
+        return c != nullptr ? c->size_bytes : 0;
+    }
+
+    // Logical CPUs sharing one level-N cache (1 if unknown)
+    int cache_sharing(int level) const
+    {
+        const Cache* c = cache(level);
+        return c != nullptr && !c->shared_cpus.empty() ? static_cast<int>(c->shared_cpus.size()) : 1;
+    }
+
+    // One-paragraph summary for logs and benchmark headers
+    std::string describe() const
+    {
+        std::string out = std::to_string(cpus.size()) + " CPUs, " + std::to_string(core_count) + " cores, "
+            + std::to_string(package_count) + (package_count == 1 ? " package, " : " packages, ")
+            + std::to_string(node_count) + (node_count == 1 ? " NUMA node, SMT " : " NUMA nodes, SMT ")
+            + std::to_string(smt_width());
+        for (int level = 1; level <= 4; ++level) {
+            if (const Cache* c = cache(level)) {
+                out += ", L" + std::to_string(level) + (c->type == "Data" ? "d " : " ")
+                    + std::to_string(c->size_bytes / 1024) + " KiB";
+                if (c->shared_cpus.size() > 1) {
+                    out += " (shared by " + std::to_string(c->shared_cpus.size()) + ")";
+                }
+            }
+        }
+        return out;
+    }
+};
+
+namespace detail {
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+    inline std::vector<int> parse_cpu_list(const std::string& text)
+    {
+        std::vector<int> out;
+        const char* p = text.c_str();
+        while (*p != '\0' && *p != '\n') {
+            char* end = nullptr;
+            const long first = std::strtol(p, &end, 10);
+            if (end == p) {
+                break;
+            }
+            long last = first;
+            p = end;
+            if (*p == '-') {
+                last = std::strtol(p + 1, &end, 10);
+                p = end;
+            }
+            for (long i = first; i <= last; ++i) {
+                out.push_back(static_cast<int>(i));
+            }
+            if (*p == ',') {
+                ++p;
+            }
+        }
+        return out;
+    }
+
+    inline bool read_line(const std::string& path, std::string& line)
+    {
+        std::ifstream in(path);
+        return static_cast<bool>(std::getline(in, line));
+    }
+
+    inline int read_int(const std::string& path, int fallback)
+    {
+        std::string line;
+        return read_line(path, line) ? std::atoi(line.c_str()) : fallback;
+    }
+
+    // "48K" / "2048K" / "32M" -> bytes
+    inline std::size_t parse_size(const std::string& text)
+    {
+        char* end = nullptr;
+        std::size_t v = std::strtoull(text.c_str(), &end, 10);
+        if (end != nullptr && (*end == 'K' || *end == 'k')) {
+            v <<= 10;
+        } else if (end != nullptr && *end == 'M') {
+            v <<= 20;
+        } else if (end != nullptr && *end == 'G') {
+            v <<= 30;
+        }
+        return v;
+    }
+
+    // CPUs the process may run on, from "Cpus_allowed_list:" in
+    // /proc/self/status; empty if it cannot be read
+    inline std::vector<int> process_allowed_cpus(const std::string& status_path = "/proc/self/status")
+    {
+        std::ifstream in(status_path);
+        constexpr std::string_view key = "Cpus_allowed_list:";
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.compare(0, key.size(), key) == 0) {
+                return parse_cpu_list(line.substr(key.size()));
+            }
+        }
+        return {};
+    }
+
+    // 'sys_root' is /sys/devices/system/ except when reading a saved copy
+    inline Topology discover(const std::string& sys_root = "/sys/devices/system/")
+    {
+        Topology t;
+        const std::string root = sys_root + "cpu/";
+        std::string line;
+        std::vector<int> ids;
+        if (read_line(root + "online", line)) {
+            ids = parse_cpu_list(line);
+        }
+        if (ids.empty()) {
+            const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned i = 0; i < n; ++i) {
+                ids.push_back(static_cast<int>(i));
+            }
+        }
+
+#if defined(__linux__)
+        // sched_getaffinity(0) is only the calling thread's mask (it may be
+        // pinned already), so it is the fallback when /proc is unavailable
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        bool have_mask = false;
+        const std::vector<int> allowed = process_allowed_cpus();
+        if (!allowed.empty()) {
+            for (int id : allowed) {
+                if (id >= 0 && id < CPU_SETSIZE) {
+                    CPU_SET(id, &mask);
+                }
+            }
+            have_mask = true;
+        } else {
+            have_mask = ::sched_getaffinity(0, sizeof(mask), &mask) == 0;
+        }
+#endif
+
+        // Cores are (package, core_id) pairs; core_id repeats across packages
+        std::map<std::pair<int, int>, int> core_index;
+        std::map<std::tuple<int, std::string, std::vector<int>>, Cache> seen_caches;
+        for (int id : ids) {
+            Cpu c;
+            c.id = id;
+            const std::string dir = root + "cpu" + std::to_string(id) + "/";
+            c.package = std::max(0, read_int(dir + "topology/physical_package_id", 0));
+            const int core_id = read_int(dir + "topology/core_id", id);
+            auto inserted = core_index.emplace(std::make_pair(c.package, core_id), static_cast<int>(core_index.size()));
+            c.core = inserted.first->second;
+            if (read_line(dir + "topology/thread_siblings_list", line)) {
+                const std::vector<int> siblings = parse_cpu_list(line);
+                auto pos = std::find(siblings.begin(), siblings.end(), id);
+                c.smt_index = pos != siblings.end() ? static_cast<int>(pos - siblings.begin()) : 0;
+            }
+#if defined(__linux__)
+            c.allowed = !have_mask || (id < CPU_SETSIZE && CPU_ISSET(id, &mask));
+#endif
+            t.cpus.push_back(c);
+
+            for (int index = 0;; ++index) {
+                const std::string cdir = dir + "cache/index" + std::to_string(index) + "/";
+                Cache cache;
+                cache.level = read_int(cdir + "level", -1);
+                if (cache.level < 0) {
+                    break;
+                }
+                read_line(cdir + "type", cache.type);
+                if (read_line(cdir + "size", line)) {
+                    cache.size_bytes = parse_size(line);
+                }
+                cache.line_bytes = static_cast<std::size_t>(std::max(0, read_int(cdir + "coherency_line_size", 0)));
+                if (read_line(cdir + "shared_cpu_list", line)) {
+                    cache.shared_cpus = parse_cpu_list(line);
+                }
+                if (cache.shared_cpus.empty()) {
+                    cache.shared_cpus.push_back(id);
+                }
+                auto key = std::make_tuple(cache.level, cache.type, cache.shared_cpus);
+                seen_caches.emplace(std::move(key), std::move(cache));
+            }
+        }
+        std::sort(t.cpus.begin(), t.cpus.end(), [](const Cpu& a, const Cpu& b) { return a.id < b.id; });
+        for (auto& entry : seen_caches) {
+            t.caches.push_back(std::move(entry.second));
+        }
+        std::sort(t.caches.begin(), t.caches.end(), [](const Cache& a, const Cache& b) {
+            return std::tie(a.level, a.type, a.shared_cpus) < std::tie(b.level, b.type, b.shared_cpus);
+        });
+
+        // NUMA nodes: /sys/devices/system/node/node<N>/cpulist
+        int nodes = 0;
+#if defined(__linux__)
+        if (DIR* d = ::opendir((sys_root + "node").c_str())) {
+            while (dirent* e = ::readdir(d)) {
+                const std::string name = e->d_name;
+                if (name.size() <= 4 || name.compare(0, 4, "node") != 0
+                    || name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                    continue;
+                }
+                const int node = std::atoi(name.c_str() + 4);
+                ++nodes;
+                if (read_line(sys_root + "node/" + name + "/cpulist", line)) {
+                    for (int id : parse_cpu_list(line)) {
+                        auto it = std::find_if(t.cpus.begin(), t.cpus.end(), [id](const Cpu& c) { return c.id == id; });
+                        if (it != t.cpus.end()) {
+                            it->node = node;
+                        }
+                    }
+                }
+            }
+            ::closedir(d);
+        }
+#endif
+        t.node_count = std::max(1, nodes);
+        t.core_count = std::max(1, static_cast<int>(core_index.size()));
+        int packages = 0;
+        for (const auto& c : t.cpus) {
+            packages = std::max(packages, c.package + 1);
+        }
+        t.package_count = std::max(1, packages);
+        return t;
+    }
+
+} // namespace detail
+
+// Discovered on first use; the topology does not change while running
+inline const Topology& get()
+{
+    static const Topology t = detail::discover();
+    return t;
+}
+
+// --- Thread Pinning ---
+// Compact:    fill a core's SMT siblings, then the next core, then the next
+//             package (threads share caches; good for communicating teams)
+// Scatter:    spread over packages first, then cores, SMT siblings last
+//             (most memory bandwidth and cache per thread)
+// OnePerCore: one hardware thread per physical core, in compact order;
+//             more threads than cores wrap around onto the same cores
+enum class Policy { Compact, Scatter, OnePerCore };
+
+inline const char* policy_name(Policy p)
+{
+    switch (p) {
+    case Policy::Compact:
+        return "compact";
+    case Policy::Scatter:
+        return "scatter";
+    case Policy::OnePerCore:
+        return "one-per-core";
+    }
+    return "?";
+}
+
+// The logical CPU for thread i = 0..n-1 under 'policy' (allowed CPUs only)
+inline std::vector<int> placement(const Topology& t, Policy policy, int n)
+{
+    std::vector<const Cpu*> order;
+    for (const auto& c : t.cpus) {
+        if (c.allowed && (policy != Policy::OnePerCore || c.smt_index == 0)) {
+            order.push_back(&c);
+        }
+    }
+    if (order.empty()) {
+        return std::vector<int>(static_cast<std::size_t>(std::max(n, 0)), -1);
+    }
+    if (policy == Policy::Scatter) {
+        // Rank each core within its package so that package 0 core 0,
+        // package 1 core 0, package 0 core 1, ... come in turn
+        std::map<int, int> rank_in_package;
+        std::map<int, int> next_rank;
+        for (const Cpu* c : order) {
+            if (rank_in_package.find(c->core) == rank_in_package.end()) {
+                rank_in_package[c->core] = next_rank[c->package]++;
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&](const Cpu* a, const Cpu* b) {
+            return std::make_tuple(a->smt_index, rank_in_package[a->core], a->package)
+                < std::make_tuple(b->smt_index, rank_in_package[b->core], b->package);
+        });
+    } else {
+        std::stable_sort(order.begin(), order.end(), [](const Cpu* a, const Cpu* b) {
+            return std::make_tuple(a->package, a->core, a->smt_index) < std::make_tuple(b->package, b->core, b->smt_index);
+        });
+    }
+    std::vector<int> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(order[static_cast<std::size_t>(i) % order.size()]->id);
+    }
+    return out;
+}
+
+inline std::vector<int> placement(Policy policy, int n)
+{
+    return placement(get(), policy, n);
+}
+
+// Restricts the calling thread to 'cpus'; false if not supported or refused
+inline bool pin_current_thread(const std::vector<int>& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return !cpus.empty() && ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+inline bool pin_current_thread(int cpu)
+{
+    return pin_current_thread(std::vector<int> { cpu });
+}
+
+// Pins the calling thread as thread 'index' of a team under 'policy'
+inline bool pin_current_thread(Policy policy, int index)
+{
+    return pin_current_thread(placement(policy, index + 1).back());
+}
+
+// Undoes pinning: every allowed CPU
+inline bool unpin_current_thread()
+{
+    std::vector<int> all;
+    for (const auto& c : get().cpus) {
+        if (c.allowed) {
+            all.push_back(c.id);
+        }
+    }
+    return pin_current_thread(all);
+}
+
+// Pins the threads of an OpenMP team of 'threads' (default
+// omp_get_max_threads()) under 'policy'. Call it outside a parallel
+// region: the runtime keeps the pinned threads for later regions of the
+// same size. Returns the number of threads pinned. OMP_PROC_BIND and
+// OMP_PLACES, when set, take precedence at the next region start on some
+// runtimes; use one mechanism or the other.
+inline int pin_omp_team(Policy policy, int threads = 0)
+{
+#if defined(_OPENMP)
+    if (threads <= 0) {
+        threads = ::omp_get_max_threads();
+    }
+    const std::vector<int> cpus = placement(policy, threads);
+    int pinned = 0;
+#pragma omp parallel num_threads(threads) reduction(+ : pinned)
+    {
+        const int i = ::omp_get_thread_num();
+        pinned += pin_current_thread(cpus[static_cast<std::size_t>(i)]) ? 1 : 0;
+    }
+    return pinned;
+#else
+    (void)threads;
+    return pin_current_thread(placement(policy, 1).front()) ? 1 : 0;
+#endif
+}
+
+} // namespace kitpp::topology
+
+#endif // KITPP_TOPOLOGY_HPP
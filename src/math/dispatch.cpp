@@ -0,0 +1,133 @@
+#include "kitpp/math/dispatch.hpp"
+#include "kitpp/log/log.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace kitpp::math {
+
+namespace {
+
+    double dot_first_call(const double* a, const double* b, std::size_t n);
+    void axpy_first_call(double alpha, const double* x, double* y, std::size_t n);
+
+    // Constant-initialized, so usable from other static constructors
+    std::atomic<detail::DotFn> g_dot { dot_first_call };
+    std::atomic<detail::AxpyFn> g_axpy { axpy_first_call };
+    std::atomic<int> g_isa { -1 };
+
+    void install(Isa isa)
+    {
+        switch (isa) {
+#if defined(KITPP_MATH_X86)
+        case Isa::Avx512:
+            g_dot.store(detail::dot_avx512, std::memory_order_relaxed);
+            g_axpy.store(detail::axpy_avx512, std::memory_order_relaxed);
+            break;
+        case Isa::Avx2:
+            g_dot.store(detail::dot_avx2, std::memory_order_relaxed);
+            g_axpy.store(detail::axpy_avx2, std::memory_order_relaxed);
+            break;
+#endif
+        default:
+            isa = Isa::Scalar;
+            g_dot.store(detail::dot_scalar, std::memory_order_relaxed);
+            g_axpy.store(detail::axpy_scalar, std::memory_order_relaxed);
+            break;
+        }
+        g_isa.store(static_cast<int>(isa), std::memory_order_release);
+    }
+
+    bool parse_isa(const char* text, Isa& out)
+    {
+        for (Isa isa : { Isa::Scalar, Isa::Avx2, Isa::Avx512 }) {
+            if (std::strcmp(text, isa_name(isa)) == 0) {
+                out = isa;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // detect_isa(), capped by KITPP_MATH_ISA
+    Isa choose_isa()
+    {
+        const Isa best = detect_isa();
+        const char* env = std::getenv("KITPP_MATH_ISA");
+        if (env == nullptr || *env == '\0') {
+            return best;
+        }
+        Isa wanted;
+        if (!parse_isa(env, wanted)) {
+            KITPP_LOG_WARNF("KITPP_MATH_ISA='{}' is not one of scalar, avx2, avx512; using {}", env, isa_name(best));
+            return best;
+        }
+        if (wanted > best) {
+            KITPP_LOG_WARNF("KITPP_MATH_ISA={} is not supported by this CPU; using {}", env, isa_name(best));
+            return best;
+        }
+        return wanted;
+    }
+
+    // Resolve on first use; racing first calls install the same kernels
+    double dot_first_call(const double* a, const double* b, std::size_t n)
+    {
+        active_isa();
+        return g_dot.load(std::memory_order_relaxed)(a, b, n);
+    }
+
+    void axpy_first_call(double alpha, const double* x, double* y, std::size_t n)
+    {
+        active_isa();
+        g_axpy.load(std::memory_order_relaxed)(alpha, x, y, n);
+    }
+
+} // namespace
+
+Isa detect_isa()
+{
+#if defined(KITPP_MATH_X86)
+    // libgcc's cpuid probe also checks XGETBV, i.e. that the OS saves the
+    // AVX / AVX-512 register state
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Isa::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return Isa::Avx2;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+Isa active_isa()
+{
+    int isa = g_isa.load(std::memory_order_acquire);
+    if (isa < 0) {
+        install(choose_isa());
+        isa = g_isa.load(std::memory_order_acquire);
+    }
+    return static_cast<Isa>(isa);
+}
+
+bool set_isa(Isa isa)
+{
+    if (isa > detect_isa()) {
+        return false;
+    }
+    install(isa);
+    return true;
+}
+
+double dot(const double* a, const double* b, std::size_t n)
+{
+    return g_dot.load(std::memory_order_relaxed)(a, b, n);
+}
+
+void axpy(double alpha, const double* x, double* y, std::size_t n)
+{
+    g_axpy.load(std::memory_order_relaxed)(alpha, x, y, n);
+}
+
+} // namespace kitpp::math
@@ -0,0 +1,66 @@
+#include "kitpp/math/dispatch.hpp"
+
+#if defined(KITPP_MATH_X86)
+
+#include <cstddef>
+#include <immintrin.h>
+
+#include "kitpp/sys/platform.hpp" // KITPP_TARGET
+
+// AVX2 + FMA variants. Only these functions are compiled for AVX2 (target
+// attribute), so the rest of the library still runs on any x86-64 CPU;
+// they are only called after the dispatcher has checked cpuid.
+
+namespace kitpp::math::detail {
+
+KITPP_TARGET("avx2,fma") double dot_avx2(const double* a, const double* b, std::size_t n)
+{
+    __m256d v0 = _mm256_setzero_pd();
+    __m256d v1 = _mm256_setzero_pd();
+    __m256d v2 = _mm256_setzero_pd();
+    __m256d v3 = _mm256_setzero_pd();
+
+    std::size_t i = 0;
+    for (; i + 15 < n; i += 16) {
+        v0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), v0);
+        v1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), v1);
+        v2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), v2);
+        v3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), v3);
+    }
+    for (; i + 3 < n; i += 4) {
+        v0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), v0);
+    }
+
+    const __m256d vsum = _mm256_add_pd(_mm256_add_pd(v0, v1), _mm256_add_pd(v2, v3));
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(vsum), _mm256_extractf128_pd(vsum, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+KITPP_TARGET("avx2,fma") void axpy_avx2(double alpha, const double* x, double* y, std::size_t n)
+{
+    const __m256d va = _mm256_set1_pd(alpha);
+    const std::ptrdiff_t blocks = static_cast<std::ptrdiff_t>(n / 16);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::ptrdiff_t b = 0; b < blocks; ++b) {
+        const std::size_t i = static_cast<std::size_t>(b) * 16;
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+        _mm256_storeu_pd(y + i + 8, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8)));
+        _mm256_storeu_pd(y + i + 12, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12)));
+    }
+    for (std::size_t i = static_cast<std::size_t>(blocks) * 16; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+} // namespace kitpp::math::detail
+
+#endif // KITPP_MATH_X86
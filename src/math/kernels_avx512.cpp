@@ -0,0 +1,67 @@
+#include "kitpp/math/dispatch.hpp"
+
+#if defined(KITPP_MATH_X86)
+
+#include <cstddef>
+#include <immintrin.h>
+
+#include "kitpp/sys/platform.hpp" // KITPP_TARGET
+
+// AVX-512F variants (8 doubles per register, masked tails). Compiled for
+// AVX-512 by target attribute only; called after the cpuid check.
+
+namespace kitpp::math::detail {
+
+KITPP_TARGET("avx512f") double dot_avx512(const double* a, const double* b, std::size_t n)
+{
+    __m512d v0 = _mm512_setzero_pd();
+    __m512d v1 = _mm512_setzero_pd();
+    __m512d v2 = _mm512_setzero_pd();
+    __m512d v3 = _mm512_setzero_pd();
+
+    std::size_t i = 0;
+    for (; i + 31 < n; i += 32) {
+        v0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), v0);
+        v1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), v1);
+        v2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), v2);
+        v3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), v3);
+    }
+    for (; i + 7 < n; i += 8) {
+        v0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), v0);
+    }
+    if (i < n) {
+        const __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1);
+        v1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a + i), _mm512_maskz_loadu_pd(m, b + i), v1);
+    }
+    // Horizontal sum through memory: _mm512_reduce_add_pd trips a false
+    // -Wuninitialized inside GCC 12's own headers
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, _mm512_add_pd(_mm512_add_pd(v0, v1), _mm512_add_pd(v2, v3)));
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+KITPP_TARGET("avx512f") void axpy_avx512(double alpha, const double* x, double* y, std::size_t n)
+{
+    const __m512d va = _mm512_set1_pd(alpha);
+    const std::ptrdiff_t blocks = static_cast<std::ptrdiff_t>(n / 32);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::ptrdiff_t b = 0; b < blocks; ++b) {
+        const std::size_t i = static_cast<std::size_t>(b) * 32;
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+        _mm512_storeu_pd(y + i + 8, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+        _mm512_storeu_pd(y + i + 16, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16)));
+        _mm512_storeu_pd(y + i + 24, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24)));
+    }
+    for (std::size_t i = static_cast<std::size_t>(blocks) * 32; i < n; i += 8) {
+        const __mmask8 m = n - i >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1u << (n - i)) - 1);
+        const __m512d r = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i));
+        _mm512_mask_storeu_pd(y + i, m, r);
+    }
+}
+
+} // namespace kitpp::math::detail
+
+#endif // KITPP_MATH_X86
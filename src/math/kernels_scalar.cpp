@@ -0,0 +1,37 @@
+#include "kitpp/math/dispatch.hpp"
+
+#include <cstddef>
+
+// Portable variants: baseline ISA, also the fallback off x86
+
+namespace kitpp::math::detail {
+
+double dot_scalar(const double* a, const double* b, std::size_t n)
+{
+    // Four chains so the adds do not wait on each other
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 3 < n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+void axpy_scalar(double alpha, const double* x, double* y, std::size_t n)
+{
+    const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(n);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+} // namespace kitpp::math::detail
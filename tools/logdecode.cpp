@@ -0,0 +1,275 @@
+// kitpp-logdecode: turns a binary log written by kitpp::log::start_binary()
+// back into the same text lines the synchronous logger prints.
+//
+// Usage: kitpp-logdecode [--timestamps] <file>
+
+#include <kitpp/log/binary.hpp>
+#include <kitpp/log/format.hpp>
+#include <kitpp/log/level.hpp>
+#include <kitpp/log/record.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace kitpp::log;
+
+struct Site {
+    Level level = Level::Info;
+    int line = 0;
+    std::string fmt;
+    std::string file;
+    std::string func;
+};
+
+struct Entry {
+    std::uint32_t site;
+    std::uint64_t ts_ns;
+    std::string_view payload;
+};
+
+// Decoded argument, formatted through the same code path as the text logger
+struct Value {
+    binary::ArgType type;
+    std::int64_t i = 0;
+    std::uint64_t u = 0;
+    double f = 0.0;
+    float f32 = 0.0f;
+    long double ld = 0.0L;
+    bool b = false;
+    char c = 0;
+    std::string_view s;
+
+    detail::FormatArg erased() const
+    {
+        switch (type) {
+        case binary::ArgType::Int: return { &i, &detail::append_erased<std::int64_t> };
+        case binary::ArgType::UInt: return { &u, &detail::append_erased<std::uint64_t> };
+        case binary::ArgType::Float: return { &f, &detail::append_erased<double> };
+        case binary::ArgType::Float32: return { &f32, &detail::append_erased<float> };
+        case binary::ArgType::LongDouble: return { &ld, &detail::append_erased<long double> };
+        case binary::ArgType::Bool: return { &b, &detail::append_erased<bool> };
+        case binary::ArgType::Char: return { &c, &detail::append_erased<char> };
+        default: return { &s, &detail::append_erased<std::string_view> };
+        }
+    }
+};
+
+class Reader {
+public:
+    Reader(const char* p, std::size_t n)
+        : p_(p)
+        , end_(p + n)
+    {
+    }
+
+    bool done() const { return p_ >= end_; }
+
+    template <typename T>
+    bool get(T& out)
+    {
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&out, p_, sizeof(T));
+        p_ += sizeof(T);
+        return true;
+    }
+
+    bool get_bytes(std::size_t n, std::string_view& out)
+    {
+        if (static_cast<std::size_t>(end_ - p_) < n) {
+            return false;
+        }
+        out = std::string_view(p_, n);
+        p_ += n;
+        return true;
+    }
+
+    bool get_str(std::string& out)
+    {
+        std::uint32_t len = 0;
+        std::string_view sv;
+        if (!get(len) || !get_bytes(len, sv)) {
+            return false;
+        }
+        out.assign(sv);
+        return true;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+bool decode_args(std::string_view payload, std::vector<Value>& values)
+{
+    values.clear();
+    Reader r(payload.data(), payload.size());
+    while (!r.done()) {
+        Value v;
+        std::uint8_t b8 = 0;
+        if (!r.get(v.type)) {
+            return false;
+        }
+        bool ok = true;
+        switch (v.type) {
+        case binary::ArgType::Int: ok = r.get(v.i); break;
+        case binary::ArgType::UInt: ok = r.get(v.u); break;
+        case binary::ArgType::Float: ok = r.get(v.f); break;
+        case binary::ArgType::Float32: ok = r.get(v.f32); break;
+        case binary::ArgType::LongDouble: ok = r.get(v.ld); break;
+        case binary::ArgType::Bool: ok = r.get(b8); v.b = b8 != 0; break;
+        case binary::ArgType::Char: ok = r.get(v.c); break;
+        case binary::ArgType::Str: {
+            std::uint32_t len = 0;
+            ok = r.get(len) && r.get_bytes(len, v.s);
+            break;
+        }
+        default: return false;
+        }
+        if (!ok) {
+            return false;
+        }
+        values.push_back(v);
+    }
+    return true;
+}
+
+void print_timestamp(std::ostream& os, std::uint64_t ts_ns)
+{
+    std::time_t secs = static_cast<std::time_t>(ts_ns / 1000000000ULL);
+    std::tm tm_buf;
+    localtime_r(&secs, &tm_buf);
+    os << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S") << '.'
+       << std::setfill('0') << std::setw(3) << (ts_ns / 1000000ULL) % 1000 << ' ';
+}
+
+int usage()
+{
+    std::cerr << "Usage: kitpp-logdecode [--timestamps] <file>\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool timestamps = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--timestamps") {
+            timestamps = true;
+        } else if (arg == "-h" || arg == "--help") {
+            return usage();
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        return usage();
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "kitpp-logdecode: cannot open " << path << '\n';
+        return 1;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Reader r(data.data(), data.size());
+    std::uint32_t version = 0;
+    std::string_view magic;
+    if (!r.get_bytes(sizeof(binary::file_magic), magic)
+        || std::memcmp(magic.data(), binary::file_magic, sizeof(binary::file_magic)) != 0
+        || !r.get(version) || version == 0 || version > binary::file_version) {
+        std::cerr << "kitpp-logdecode: " << path << " is not a kitpp binary log (version " << binary::file_version << ")\n";
+        return 1;
+    }
+
+    std::unordered_map<std::uint32_t, Site> sites;
+    std::vector<Entry> entries;
+    bool truncated = false;
+    while (!r.done()) {
+        binary::EntryTag tag;
+        if (!r.get(tag)) {
+            truncated = true;
+            break;
+        }
+        if (tag == binary::EntryTag::Site) {
+            std::uint32_t id = 0, line = 0;
+            std::uint8_t level = 0;
+            Site site;
+            if (!r.get(id) || !r.get(level) || !r.get(line) || !r.get_str(site.fmt)
+                || !r.get_str(site.file) || !r.get_str(site.func)) {
+                truncated = true;
+                break;
+            }
+            site.level = static_cast<Level>(level);
+            site.line = static_cast<int>(line);
+            sites[id] = std::move(site);
+        } else if (tag == binary::EntryTag::Record) {
+            Entry e;
+            std::uint16_t len = 0;
+            if (!r.get(e.site) || !r.get(e.ts_ns) || !r.get(len) || !r.get_bytes(len, e.payload)) {
+                truncated = true;
+                break;
+            }
+            entries.push_back(e);
+        } else {
+            truncated = true;
+            break;
+        }
+    }
+
+    // Threads flush their buffers independently; restore global time order
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b) { return a.ts_ns < b.ts_ns; });
+
+    std::vector<Value> values;
+    std::vector<detail::FormatArg> args;
+    std::string message;
+    for (const Entry& e : entries) {
+        auto it = sites.find(e.site);
+        if (it == sites.end() || !decode_args(e.payload, values)) {
+            std::cerr << "kitpp-logdecode: skipping malformed record (site " << e.site << ")\n";
+            continue;
+        }
+        const Site& site = it->second;
+        args.clear();
+        for (const Value& v : values) {
+            args.push_back(v.erased());
+        }
+        message.clear();
+        detail::vformat_to(message, site.fmt, args.data(), args.size());
+
+        detail::RecordView rec;
+        rec.level_str = detail::level_label(site.level);
+        rec.level_color = detail::level_color(site.level);
+        rec.file = site.file.c_str();
+        rec.line = site.line;
+        rec.func = site.func.c_str();
+        rec.message = message;
+        if (timestamps) {
+            print_timestamp(std::cout, e.ts_ns);
+        }
+        detail::write_record(std::cout, rec);
+    }
+
+    if (truncated) {
+        std::cerr << "kitpp-logdecode: file ends with an incomplete entry\n";
+    }
+    return 0;
+}